@@ -12,7 +12,8 @@ public class InteractionSystem : ModuleRules
 			{
 				"Core",
 				"NetCore",
-				"UMG"
+				"UMG",
+				"GameplayTags"
 			});
 		
 		PrivateDependencyModuleNames.AddRange(new string[]
@@ -0,0 +1,91 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#if !UE_BUILD_SHIPPING
+
+#include "InteractionBenchmarkUtils.h"
+
+#include "Components/SphereComponent.h"
+#include "Components/ActorComponents/InteractableComponent.h"
+#include "Components/ActorComponents/InteractionManagerComponent.h"
+#include "GameFramework/Pawn.h"
+
+namespace InteractionBenchmarkUtils
+{
+	FSpawnedActors::FSpawnedActors(UWorld* InWorld)
+		: World(InWorld)
+	{
+		SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		SpawnParameters.ObjectFlags = RF_Transient;
+	}
+
+	FSpawnedActors::~FSpawnedActors()
+	{
+		for (const TWeakObjectPtr<AActor>& Actor : Actors)
+		{
+			if (Actor.IsValid())
+			{
+				Actor->Destroy();
+			}
+		}
+	}
+
+	AActor* FSpawnedActors::SpawnSphereActor(const FVector& Location, const float Radius,
+		const bool bGenerateOverlapEvents)
+	{
+		AActor* Actor = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform(Location), SpawnParameters);
+
+		USphereComponent* SphereComponent = NewObject<USphereComponent>(Actor);
+		SphereComponent->InitSphereRadius(Radius);
+		SphereComponent->SetCollisionProfileName(TEXT("OverlapAllDynamic"));
+		SphereComponent->SetGenerateOverlapEvents(bGenerateOverlapEvents);
+		SphereComponent->SetWorldLocation(Location);
+
+		Actor->SetRootComponent(SphereComponent);
+		SphereComponent->RegisterComponent();
+
+		Actors.Add(Actor);
+
+		return Actor;
+	}
+
+	AActor* FSpawnedActors::SpawnInteractable(const FVector& Location, const bool bGenerateOverlapEvents)
+	{
+		AActor* Actor = SpawnSphereActor(Location, 50.0f, bGenerateOverlapEvents);
+
+		// Registered after the root component, so the interactable is added to the grid at the right location
+		UInteractableComponent* InteractableComponent = NewObject<UInteractableComponent>(Actor);
+		InteractableComponent->SetCanInteract(true);
+		InteractableComponent->RegisterComponent();
+
+		return Actor;
+	}
+
+	UInteractionManagerComponent* FSpawnedActors::SpawnBot(const FVector& Location)
+	{
+		APawn* Bot = World->SpawnActor<APawn>(APawn::StaticClass(), FTransform(Location), SpawnParameters);
+
+		UInteractionManagerComponent* InteractionManager = NewObject<UInteractionManagerComponent>(Bot);
+		Bot->SetRootComponent(InteractionManager);
+		InteractionManager->SetWorldLocation(Location);
+		InteractionManager->RegisterComponent();
+
+		Actors.Add(Bot);
+
+		return InteractionManager;
+	}
+
+	double MeasureSeconds(const TFunctionRef<void()> Function)
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		Function();
+
+		return FPlatformTime::Seconds() - StartTime;
+	}
+
+	int32 GetIntArgument(const TArray<FString>& Args, const int32 Index, const int32 DefaultValue)
+	{
+		return Args.IsValidIndex(Index) ? FMath::Max(FCString::Atoi(*Args[Index]), 1) : DefaultValue;
+	}
+}
+
+#endif
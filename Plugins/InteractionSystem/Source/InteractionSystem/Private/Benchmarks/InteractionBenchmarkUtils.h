@@ -0,0 +1,66 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#if !UE_BUILD_SHIPPING
+
+#include "CoreMinimal.h"
+#include "EngineUtils.h"
+
+class UInteractionManagerComponent;
+
+// Helpers shared by the benchmark console commands of the interaction system
+namespace InteractionBenchmarkUtils
+{
+	// Benchmark actors are spawned around this location, far away from the geometry and the interactables of the level
+	const FVector Origin(0.0f, 0.0f, 100000.0f);
+
+	// Spawns the transient actors of a benchmark and destroys them when it goes out of scope
+	class FSpawnedActors
+	{
+	public:
+		explicit FSpawnedActors(UWorld* InWorld);
+		~FSpawnedActors();
+
+		// Spawns an actor with a sphere root component that overlaps everything dynamic
+		AActor* SpawnSphereActor(const FVector& Location, const float Radius, const bool bGenerateOverlapEvents);
+
+		// Spawns an actor with an interactable component that can be interacted with but has no interaction logic
+		AActor* SpawnInteractable(const FVector& Location, const bool bGenerateOverlapEvents = false);
+
+		// Spawns a pawn with an interaction manager as its root component
+		UInteractionManagerComponent* SpawnBot(const FVector& Location);
+
+	private:
+		UWorld* World;
+
+		FActorSpawnParameters SpawnParameters;
+		TArray<TWeakObjectPtr<AActor>> Actors;
+	};
+
+	// Returns the time in seconds the function took to execute
+	double MeasureSeconds(const TFunctionRef<void()> Function);
+
+	// Returns the argument at the given index parsed as a number of at least 1, or the default value if there is none
+	int32 GetIntArgument(const TArray<FString>& Args, const int32 Index, const int32 DefaultValue);
+
+	// Gathers the components of the given type of all actors in the world that have begun play
+	template<typename T>
+	void GetComponents(UWorld* World, TArray<T*>& OutComponents)
+	{
+		OutComponents.Reset();
+
+		for (TActorIterator<AActor> It(World); It; ++It)
+		{
+			It->ForEachComponent<T>(false, [&OutComponents](T* Component)
+			{
+				if (Component->HasBegunPlay())
+				{
+					OutComponents.Add(Component);
+				}
+			});
+		}
+	}
+}
+
+#endif
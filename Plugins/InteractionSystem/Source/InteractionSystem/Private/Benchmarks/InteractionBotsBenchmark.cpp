@@ -0,0 +1,103 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#if !UE_BUILD_SHIPPING
+
+#include "InteractionBenchmarkUtils.h"
+#include "InteractionSystem.h"
+#include "Components/ActorComponents/InteractableComponent.h"
+#include "Components/ActorComponents/InteractionManagerComponent.h"
+
+/**
+ * Spawns the given number of bot pawns with interaction managers far away from the level, each with an interactable
+ * next to it, and measures the per-bot cost of finding the nearest interactable and of interacting with it directly
+ * (InteractAsAuthority) and through the server validation that Server_TryInteract runs for remote players. The test
+ * interactables have no interaction logic, so only the overhead of the interaction system is measured.
+ * Usage: Interaction.Bots.Benchmark [BotsNumber] [InteractionsPerBot]
+ */
+static FAutoConsoleCommandWithWorldAndArgs InteractionBotsBenchmarkCommand(
+	TEXT("Interaction.Bots.Benchmark"),
+	TEXT("Measures the per-bot cost of the interaction queries and of the direct and validated server interactions."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		using namespace InteractionBenchmarkUtils;
+
+		if (World->GetNetMode() == NM_Client)
+		{
+			UE_LOG(LogInteractionSystem, Warning, TEXT("Interaction.Bots.Benchmark: Must be run on the server"));
+
+			return;
+		}
+
+		const int32 BotsNumber = GetIntArgument(Args, 0, 100);
+		const int32 InteractionsPerBot = GetIntArgument(Args, 1, 5);
+
+		FSpawnedActors SpawnedActors(World);
+
+		TArray<UInteractionManagerComponent*> InteractionManagers;
+		InteractionManagers.Reserve(BotsNumber);
+
+		// Place the bots far enough from each other to not see the interactables of the others
+		const int32 RowSize = FMath::CeilToInt32(FMath::Sqrt(static_cast<float>(BotsNumber)));
+
+		for (int32 i = 0; i < BotsNumber; ++i)
+		{
+			const FVector BotLocation = Origin + FVector(i % RowSize, i / RowSize, 0.0f) * 2000.0f;
+
+			InteractionManagers.Add(SpawnedActors.SpawnBot(BotLocation));
+			SpawnedActors.SpawnInteractable(BotLocation + FVector(100.0f, 0.0f, 0.0f));
+		}
+
+		TArray<UInteractableComponent*> Targets;
+		Targets.Reserve(BotsNumber);
+
+		const double QueryTime = MeasureSeconds([&]
+		{
+			for (const UInteractionManagerComponent* InteractionManager : InteractionManagers)
+			{
+				Targets.Add(InteractionManager->FindNearestInteractable(FGameplayTag(),
+					InteractionManager->GetMaxInteractionDistance()));
+			}
+		});
+
+		int32 DirectInteractionsNumber = 0;
+
+		const double DirectTime = MeasureSeconds([&]
+		{
+			for (int32 Iteration = 0; Iteration < InteractionsPerBot; ++Iteration)
+			{
+				for (int32 i = 0; i < BotsNumber; ++i)
+				{
+					DirectInteractionsNumber += InteractionManagers[i]->InteractAsAuthority(Targets[i]);
+				}
+			}
+		});
+
+		int32 ValidatedInteractionsNumber = 0;
+
+		const double ValidatedTime = MeasureSeconds([&]
+		{
+			for (int32 Iteration = 0; Iteration < InteractionsPerBot; ++Iteration)
+			{
+				for (int32 i = 0; i < BotsNumber; ++i)
+				{
+					if (InteractionManagers[i]->ValidateServerInteraction(Targets[i]))
+					{
+						Targets[i]->Interact(InteractionManagers[i]);
+
+						++ValidatedInteractionsNumber;
+					}
+				}
+			}
+		});
+
+		const int32 InteractionsNumber = BotsNumber * InteractionsPerBot;
+
+		UE_LOG(LogInteractionSystem, Display,
+			TEXT("Interaction.Bots.Benchmark: %d bots x %d interactions. Query: %.3f us per bot. Direct: %.3f us per "
+				"interaction (%d succeeded). Validated: %.3f us per interaction (%d succeeded)."),
+			BotsNumber, InteractionsPerBot, QueryTime * 1000000.0 / BotsNumber,
+			DirectTime * 1000000.0 / InteractionsNumber, DirectInteractionsNumber,
+			ValidatedTime * 1000000.0 / InteractionsNumber, ValidatedInteractionsNumber);
+	}));
+
+#endif
@@ -0,0 +1,130 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#if !UE_BUILD_SHIPPING
+
+#include "InteractionBenchmarkUtils.h"
+#include "InteractionSystem.h"
+#include "Components/ActorComponents/InteractableComponent.h"
+#include "Subsystems/InteractableGridSubsystem.h"
+
+/**
+ * Spawns the given number of interactables and pawn detection zones far away from the level and moves the zones to
+ * random locations between the interactables. Compares the cost of the overlap updates the zones generate when they
+ * move (the way UInteractionManagerComponent used to fill its pool) with grid queries at the same locations.
+ * Usage: Interaction.Grid.Benchmark [InteractablesNumber] [PawnsNumber] [NumIterations] [Radius]
+ */
+static FAutoConsoleCommandWithWorldAndArgs InteractionGridBenchmarkCommand(
+	TEXT("Interaction.Grid.Benchmark"),
+	TEXT("Compares UInteractableGridSubsystem queries with overlap updates of moving pawn detection zones."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		using namespace InteractionBenchmarkUtils;
+
+		const UInteractableGridSubsystem* GridSubsystem = World->GetSubsystem<UInteractableGridSubsystem>();
+
+		if (!IsValid(GridSubsystem))
+		{
+			return;
+		}
+
+		const int32 InteractablesNumber = GetIntArgument(Args, 0, 5000);
+		const int32 PawnsNumber = GetIntArgument(Args, 1, 64);
+		const int32 NumIterations = GetIntArgument(Args, 2, 100);
+		const float Radius = Args.IsValidIndex(3) ? FMath::Max(FCString::Atof(*Args[3]), 1.0f) : 500.0f;
+
+		// Keep the same density of interactables for any number of them: one interactable per 2x2 meters
+		const float AreaSize = FMath::Sqrt(static_cast<float>(InteractablesNumber)) * 200.0f;
+
+		FRandomStream RandomStream(InteractablesNumber);
+
+		const auto GetRandomLocation = [&RandomStream, AreaSize]()
+		{
+			return Origin + FVector(RandomStream.FRandRange(0.0f, AreaSize), RandomStream.FRandRange(0.0f, AreaSize),
+				RandomStream.FRandRange(0.0f, 200.0f));
+		};
+
+		FSpawnedActors SpawnedActors(World);
+
+		for (int32 i = 0; i < InteractablesNumber; ++i)
+		{
+			SpawnedActors.SpawnInteractable(GetRandomLocation(), true);
+		}
+
+		TArray<AActor*> PawnZones;
+		PawnZones.Reserve(PawnsNumber);
+
+		for (int32 i = 0; i < PawnsNumber; ++i)
+		{
+			PawnZones.Add(SpawnedActors.SpawnSphereActor(GetRandomLocation(), Radius, true));
+		}
+
+		// Every pawn walks a random path, and both approaches process the same locations
+		TArray<FVector> PawnLocations;
+		PawnLocations.Reserve(PawnsNumber * NumIterations);
+
+		for (int32 i = 0; i < PawnsNumber * NumIterations; ++i)
+		{
+			PawnLocations.Add(GetRandomLocation());
+		}
+
+		int64 OverlapsChecksum = 0;
+
+		const double OverlapsTime = MeasureSeconds([&]
+		{
+			for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+			{
+				for (int32 PawnIndex = 0; PawnIndex < PawnsNumber; ++PawnIndex)
+				{
+					AActor* PawnZone = PawnZones[PawnIndex];
+					PawnZone->SetActorLocation(PawnLocations[Iteration * PawnsNumber + PawnIndex]);
+
+					TSet<AActor*> OverlappingActors;
+					PawnZone->GetOverlappingActors(OverlappingActors);
+
+					for (const AActor* OverlappingActor : OverlappingActors)
+					{
+						if (OverlappingActor->FindComponentByClass<UInteractableComponent>())
+						{
+							++OverlapsChecksum;
+						}
+					}
+				}
+			}
+		});
+
+		// Pawns don't need overlaps anymore with the grid
+		for (AActor* PawnZone : PawnZones)
+		{
+			CastChecked<UPrimitiveComponent>(PawnZone->GetRootComponent())->SetGenerateOverlapEvents(false);
+		}
+
+		int64 GridChecksum = 0;
+		TArray<UInteractableComponent*> FoundInteractables;
+
+		const double GridTime = MeasureSeconds([&]
+		{
+			for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+			{
+				for (int32 PawnIndex = 0; PawnIndex < PawnsNumber; ++PawnIndex)
+				{
+					GridSubsystem->FindInteractablesInRadius(PawnLocations[Iteration * PawnsNumber + PawnIndex],
+						Radius, FoundInteractables);
+
+					GridChecksum += FoundInteractables.Num();
+				}
+			}
+		});
+
+		const int32 QueriesNumber = PawnsNumber * NumIterations;
+
+		// Checksums differ slightly since overlaps test the spheres of the interactables and the grid tests locations
+		UE_LOG(LogInteractionSystem, Display,
+			TEXT("Interaction.Grid.Benchmark: %d interactables, %d pawns x %d iterations, radius %.0f, cell size %.0f. "
+				"Grid: %.3f ms (%.3f us per query, checksum %lld). Overlaps: %.3f ms (%.3f us per move, "
+				"checksum %lld)."),
+			InteractablesNumber, PawnsNumber, NumIterations, Radius, GridSubsystem->GetCellSize(), GridTime * 1000.0,
+			GridTime * 1000000.0 / QueriesNumber, GridChecksum, OverlapsTime * 1000.0,
+			OverlapsTime * 1000000.0 / QueriesNumber, OverlapsChecksum);
+	}));
+
+#endif
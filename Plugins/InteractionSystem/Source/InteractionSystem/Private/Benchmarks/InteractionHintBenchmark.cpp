@@ -0,0 +1,52 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#if !UE_BUILD_SHIPPING
+
+#include "InteractionBenchmarkUtils.h"
+#include "InteractionSystem.h"
+#include "Components/ActorComponents/InteractableComponent.h"
+
+/**
+ * Measures the game-thread cost of a selection change by showing and hiding the hint of every interactable with hint
+ * meshes in the world. Run it on maps whose interactables use the overlay material and on maps whose interactables
+ * use bHintUsesCustomDepth to compare them. The render thread cost is visible in stat scenerendering, and the per-frame
+ * cost of the shown hint in stat gpu (the overlay draws of the hinted meshes or the custom depth pass and the outline).
+ * Usage: Interaction.Hint.Benchmark [Iterations=100]
+ */
+static FAutoConsoleCommandWithWorldAndArgs InteractionHintBenchmarkCommand(
+	TEXT("Interaction.Hint.Benchmark"),
+	TEXT("Measures the game-thread time of showing and hiding the hint of every interactable in the world."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		using namespace InteractionBenchmarkUtils;
+
+		const int32 NumIterations = GetIntArgument(Args, 0, 100);
+
+		TArray<UInteractableComponent*> InteractableComponents;
+		GetComponents(World, InteractableComponents);
+
+		if (InteractableComponents.IsEmpty())
+		{
+			return;
+		}
+
+		const double ElapsedTime = MeasureSeconds([&]
+		{
+			for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+			{
+				for (UInteractableComponent* InteractableComponent : InteractableComponents)
+				{
+					InteractableComponent->SetInteractionHintVisibility(true);
+					InteractableComponent->SetInteractionHintVisibility(false);
+				}
+			}
+		});
+
+		const int32 SelectionChangesNumber = NumIterations * InteractableComponents.Num() * 2;
+
+		UE_LOG(LogInteractionSystem, Display,
+			TEXT("Interaction.Hint.Benchmark: %d interactables x %d iterations. %.3f us per selection change."),
+			InteractableComponents.Num(), NumIterations, ElapsedTime * 1000000.0 / SelectionChangesNumber);
+	}));
+
+#endif
@@ -0,0 +1,54 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#if !UE_BUILD_SHIPPING
+
+#include "InteractionBenchmarkUtils.h"
+#include "InteractionSystem.h"
+#include "Components/WidgetComponent.h"
+#include "Components/ActorComponents/InteractableComponent.h"
+#include "Widgets/InteractPopupWidget.h"
+
+/**
+ * Logs the numbers of interactables, widget components and interaction popups in the world and the estimated memory of
+ * the widget components and the popups. Run it on the server and on a client on a large map to check that only the
+ * shared popup pool of the local player is left and the interactables don't keep their own popup widget components.
+ * Usage: Interaction.Popups.Report
+ */
+static FAutoConsoleCommandWithWorld InteractionPopupsReportCommand(
+	TEXT("Interaction.Popups.Report"),
+	TEXT("Logs the numbers of interactables, widget components and interaction popups and their estimated memory."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		using namespace InteractionBenchmarkUtils;
+
+		TArray<UInteractableComponent*> InteractableComponents;
+		GetComponents(World, InteractableComponents);
+
+		TArray<UWidgetComponent*> WidgetComponents;
+		GetComponents(World, WidgetComponents);
+
+		SIZE_T WidgetComponentsMemory = 0;
+		int32 PopupWidgetsNumber = 0;
+		SIZE_T PopupWidgetsMemory = 0;
+
+		for (UWidgetComponent* WidgetComponent : WidgetComponents)
+		{
+			WidgetComponentsMemory += WidgetComponent->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal);
+
+			UInteractPopupWidget* PopupWidget = Cast<UInteractPopupWidget>(WidgetComponent->GetWidget());
+
+			if (IsValid(PopupWidget))
+			{
+				++PopupWidgetsNumber;
+				PopupWidgetsMemory += PopupWidget->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal);
+			}
+		}
+
+		UE_LOG(LogInteractionSystem, Display,
+			TEXT("Interaction.Popups.Report (%s): %d interactables. Widget components: %d (%.1f KB). Popup widgets: %d "
+				"(%.1f KB)."),
+			World->GetNetMode() == NM_Client ? TEXT("client") : TEXT("server"), InteractableComponents.Num(),
+			WidgetComponents.Num(), WidgetComponentsMemory / 1024.0, PopupWidgetsNumber, PopupWidgetsMemory / 1024.0);
+	}));
+
+#endif
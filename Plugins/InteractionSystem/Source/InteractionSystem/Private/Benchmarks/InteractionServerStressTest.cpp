@@ -0,0 +1,103 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#if !UE_BUILD_SHIPPING
+
+#include "InteractionBenchmarkUtils.h"
+#include "InteractionSystem.h"
+#include "Components/ActorComponents/InteractableComponent.h"
+#include "Components/ActorComponents/InteractionManagerComponent.h"
+#include "Subsystems/InteractableGridSubsystem.h"
+
+/**
+ * Sends the given number of interaction requests to the server validation of the first interaction manager in the world
+ * at the interactable nearest to it in a single frame, like a modified client flooding Server_TryInteract would do, and
+ * logs how many of them were dropped and how long it took. The number of traces is counted by the ValidationTraces
+ * stat of the Interaction CSV category and of stat Interaction. The interaction itself isn't executed. Run it on the
+ * server with Interaction.ServerValidationLimits set to 0 and to 1 to compare.
+ * Usage: Interaction.Server.StressTest [RequestsNumber]
+ */
+static FAutoConsoleCommandWithWorldAndArgs InteractionServerStressTestCommand(
+	TEXT("Interaction.Server.StressTest"),
+	TEXT("Floods the server validation of interaction requests and logs its cost."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		using namespace InteractionBenchmarkUtils;
+
+		if (World->GetNetMode() == NM_Client)
+		{
+			UE_LOG(LogInteractionSystem, Warning, TEXT("Interaction.Server.StressTest: Must be run on the server"));
+
+			return;
+		}
+
+		const int32 RequestsNumber = GetIntArgument(Args, 0, 10000);
+
+		TArray<UInteractionManagerComponent*> InteractionManagers;
+		GetComponents(World, InteractionManagers);
+
+		const UInteractableGridSubsystem* GridSubsystem = World->GetSubsystem<UInteractableGridSubsystem>();
+
+		if (InteractionManagers.IsEmpty() || !IsValid(GridSubsystem))
+		{
+			UE_LOG(LogInteractionSystem, Warning,
+				TEXT("Interaction.Server.StressTest: There is no interaction manager in the world"));
+
+			return;
+		}
+
+		UInteractionManagerComponent* InteractionManager = InteractionManagers[0];
+		const FVector InstigatorLocation = InteractionManager->GetOwner()->GetActorLocation();
+
+		TArray<UInteractableComponent*> FoundInteractables;
+		GridSubsystem->FindInteractablesInRadius(InstigatorLocation, InteractionManager->GetMaxInteractionDistance(),
+			FoundInteractables);
+
+		const UInteractableComponent* Target = nullptr;
+		double BestDistanceSquared = TNumericLimits<double>::Max();
+
+		for (const UInteractableComponent* InteractableComponent : FoundInteractables)
+		{
+			const double DistanceSquared = FVector::DistSquared(InstigatorLocation,
+				InteractableComponent->GetOwner()->GetActorLocation());
+
+			if (InteractableComponent->GetOwner() != InteractionManager->GetOwner() &&
+				DistanceSquared < BestDistanceSquared)
+			{
+				Target = InteractableComponent;
+				BestDistanceSquared = DistanceSquared;
+			}
+		}
+
+		if (!Target)
+		{
+			UE_LOG(LogInteractionSystem, Warning,
+				TEXT("Interaction.Server.StressTest: There is no interactable near the interaction manager"));
+
+			return;
+		}
+
+		int32 AcceptedRequestsNumber = 0;
+
+		const double ElapsedTime = MeasureSeconds([&]
+		{
+			for (int32 i = 0; i < RequestsNumber; ++i)
+			{
+				if (InteractionManager->ValidateServerInteraction(Target))
+				{
+					++AcceptedRequestsNumber;
+				}
+			}
+		});
+
+		const IConsoleVariable* ServerValidationLimitsVariable =
+			IConsoleManager::Get().FindConsoleVariable(TEXT("Interaction.ServerValidationLimits"));
+
+		UE_LOG(LogInteractionSystem, Display,
+			TEXT("Interaction.Server.StressTest (validation limits %s): %d requests, %d accepted, %d dropped. %.3f ms "
+				"total, %.3f us per request."),
+			ServerValidationLimitsVariable && ServerValidationLimitsVariable->GetBool() ? TEXT("on") : TEXT("off"),
+			RequestsNumber, AcceptedRequestsNumber, RequestsNumber - AcceptedRequestsNumber, ElapsedTime * 1000.0,
+			ElapsedTime * 1000000.0 / RequestsNumber);
+	}));
+
+#endif
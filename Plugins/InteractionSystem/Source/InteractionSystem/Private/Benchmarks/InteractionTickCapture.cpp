@@ -0,0 +1,63 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#if !UE_BUILD_SHIPPING
+
+#include "InteractionBenchmarkUtils.h"
+#include "Algo/Count.h"
+#include "InteractionSystem.h"
+#include "Components/ActorComponents/InteractionManagerComponent.h"
+
+/**
+ * Starts a CSV capture of the given number of frames named after the current value of Interaction.ChangeDrivenSelection
+ * and logs how many interaction managers are ticking. The Interaction category of the capture has the tick time and the
+ * number of ticks of interaction managers of players and bots (PlayerManagerTickTime, BotManagerTickTime, ...) and the
+ * numbers of selections, line-of-sight checks and traces per frame. Run it with Interaction.ChangeDrivenSelection set
+ * to 0 and to 1 on the same map to compare the every-frame selection with the change-driven one.
+ * Usage: Interaction.Tick.Capture [FramesNumber]
+ */
+static FAutoConsoleCommandWithWorldAndArgs InteractionTickCaptureCommand(
+	TEXT("Interaction.Tick.Capture"),
+	TEXT("Starts a CSV capture of the ticks of interaction managers of players and bots."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		using namespace InteractionBenchmarkUtils;
+
+#if CSV_PROFILER
+		FCsvProfiler* CsvProfiler = FCsvProfiler::Get();
+
+		if (CsvProfiler->IsCapturing())
+		{
+			UE_LOG(LogInteractionSystem, Warning, TEXT("Interaction.Tick.Capture: A CSV capture is already running"));
+
+			return;
+		}
+
+		const int32 FramesNumber = GetIntArgument(Args, 0, 1000);
+
+		TArray<UInteractionManagerComponent*> InteractionManagers;
+		GetComponents(World, InteractionManagers);
+
+		const int32 TickingManagersNumber = Algo::CountIf(InteractionManagers,
+			[](const UInteractionManagerComponent* InteractionManager)
+			{
+				return InteractionManager->IsComponentTickEnabled();
+			});
+
+		const IConsoleVariable* ChangeDrivenSelectionVariable =
+			IConsoleManager::Get().FindConsoleVariable(TEXT("Interaction.ChangeDrivenSelection"));
+
+		const FString Filename = FString::Printf(TEXT("InteractionTick_ChangeDriven%d_%s.csv"),
+			ChangeDrivenSelectionVariable && ChangeDrivenSelectionVariable->GetBool() ? 1 : 0,
+			*FDateTime::Now().ToString());
+
+		CsvProfiler->BeginCapture(FramesNumber, FString(), Filename);
+
+		UE_LOG(LogInteractionSystem, Display,
+			TEXT("Interaction.Tick.Capture: Capturing %d frames to %s, %d of %d managers ticking now."),
+			FramesNumber, *Filename, TickingManagersNumber, InteractionManagers.Num());
+#else
+		UE_LOG(LogInteractionSystem, Warning, TEXT("Interaction.Tick.Capture: The CSV profiler is disabled"));
+#endif
+	}));
+
+#endif
@@ -2,66 +2,177 @@
 
 #include "InteractionSystem/Public/Components/ActorComponents/InteractableComponent.h"
 
+#include "InteractionSystem.h"
 #include "Components/WidgetComponent.h"
-#include "Widgets/InteractPopupWidget.h"
+#include "GameFramework/GameStateBase.h"
+#include "Net/UnrealNetwork.h"
+#include "Subsystems/InteractableGridSubsystem.h"
+
+DECLARE_CYCLE_STAT(TEXT("Set Hint Visibility"), STAT_InteractionSetHintVisibility, STATGROUP_Interaction);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Hint Material Swaps"), STAT_InteractionHintMaterialSwaps, STATGROUP_Interaction);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Hint Custom Depth Toggles"), STAT_InteractionHintCustomDepthToggles,
+	STATGROUP_Interaction);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Holds Started"), STAT_InteractionHoldsStarted, STATGROUP_Interaction);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Holds Completed"), STAT_InteractionHoldsCompleted, STATGROUP_Interaction);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Holds Rejected"), STAT_InteractionHoldsRejected, STATGROUP_Interaction);
 
 UInteractableComponent::UInteractableComponent()
 {
 	PrimaryComponentTick.bCanEverTick = false;
 }
 
+void UInteractableComponent::PostInitProperties()
+{
+	Super::PostInitProperties();
+
+	// Instant interactions don't have any state to replicate, so only the interactables with a hold pay for it
+	if (IsHoldInteraction())
+	{
+		SetIsReplicatedByDefault(true);
+	}
+}
+
+#if WITH_EDITOR
+void UInteractableComponent::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	// HoldDuration of placed instances is loaded after PostInitProperties, so the replication is saved with them
+	if (PropertyChangedEvent.GetMemberPropertyName() == GET_MEMBER_NAME_CHECKED(ThisClass, HoldDuration))
+	{
+		SetIsReplicated(IsHoldInteraction());
+	}
+}
+#endif
+
+void UInteractableComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	// The hold state changes only when a hold is started or stopped, so it's only compared when it's marked dirty
+	FDoRepLifetimeParams Params;
+	Params.bIsPushBased = true;
+
+	DOREPLIFETIME_WITH_PARAMS_FAST(ThisClass, HoldState, Params);
+}
+
 void UInteractableComponent::BeginPlay()
 {
 	Super::BeginPlay();
 
-	InitializeHintMeshes();
+#if DO_ENSURE
+	ensureAlwaysMsgf(!IsHoldInteraction() || (GetOwner()->GetIsReplicated() && GetIsReplicated()),
+		TEXT("%s has a hold interaction, but it doesn't replicate, so clients never see the hold progress!"),
+		*GetOwner()->GetName());
+#endif
+
+	// Also on headless servers, so they don't keep the own popup widget components of the interactables
 	InitializeHintWidget();
+
+	// Nothing is ever shown on headless servers, so they skip the rest of the hint path
+	if (!IsRunningDedicatedServer())
+	{
+		InitializeHintMeshes();
+	}
+
+	UInteractableGridSubsystem* GridSubsystem = GetWorld()->GetSubsystem<UInteractableGridSubsystem>();
+
+	if (!ensureAlways(IsValid(GridSubsystem)))
+	{
+		return;
+	}
+
+	GridSubsystem->RegisterInteractable(this);
+
+	USceneComponent* OwnerRootComponent = GetOwner()->GetRootComponent();
+
+	// Actors without a root component can't move, so there is nothing to update
+	if (IsValid(OwnerRootComponent))
+	{
+		OwnerTransformUpdatedDelegateHandle = OwnerRootComponent->TransformUpdated.AddUObject(this,
+			&ThisClass::OnOwnerTransformUpdated);
+	}
+}
+
+void UInteractableComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	USceneComponent* OwnerRootComponent = GetOwner()->GetRootComponent();
+
+	if (IsValid(OwnerRootComponent))
+	{
+		OwnerRootComponent->TransformUpdated.Remove(OwnerTransformUpdatedDelegateHandle);
+	}
+
+	OwnerTransformUpdatedDelegateHandle.Reset();
+
+	UInteractableGridSubsystem* GridSubsystem = GetWorld()->GetSubsystem<UInteractableGridSubsystem>();
+
+	if (IsValid(GridSubsystem))
+	{
+		GridSubsystem->UnregisterInteractable(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+// ReSharper disable once CppParameterMayBeConstPtrOrRef
+void UInteractableComponent::OnOwnerTransformUpdated(USceneComponent* UpdatedComponent,
+	EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
+{
+	UInteractableGridSubsystem* GridSubsystem = GetWorld()->GetSubsystem<UInteractableGridSubsystem>();
+
+	if (ensureAlways(IsValid(GridSubsystem)))
+	{
+		GridSubsystem->UpdateInteractableLocation(this);
+	}
 }
 
 void UInteractableComponent::InitializeHintMeshes()
 {
 	TInlineComponentArray<UMeshComponent*> MeshComponents;
 	GetOwner()->GetComponents(UMeshComponent::StaticClass(), MeshComponents);
-	
-	bool HasMeshWithGenerateOverlapEvents = false;
-	
+
 	for (UMeshComponent* MeshComponent : MeshComponents)
 	{
 		if (!MeshComponent->ComponentHasTag(HintMeshTag))
 		{
 			continue;
 		}
-		
-		if (MeshComponent->GetGenerateOverlapEvents())
-		{
-			HasMeshWithGenerateOverlapEvents = true;
-		}
-		
+
 		HintMeshes.Add(MeshComponent);
 	}
-
-#if DO_ENSURE
-	ensureAlwaysMsgf(HasMeshWithGenerateOverlapEvents,
-		TEXT("CastedMesh must be set GenerateOverlapEvents to true, otherwise it will not be included in "
-			"UInteractionManagerComponent::InteractableComponentsPool!"));
-#endif
 }
 
 void UInteractableComponent::InitializeHintWidget()
 {
-	const UWidgetComponent* WidgetComponent = GetOwner()->FindComponentByTag<UWidgetComponent>(HintWidgetTag);
+	USceneComponent* AnchorComponent = GetOwner()->FindComponentByTag<USceneComponent>(HintWidgetTag);
 	
-	if (!IsValid(WidgetComponent))
+	if (!IsValid(AnchorComponent))
 	{
 		return;
 	}
 
-	UInteractPopupWidget* Widget = Cast<UInteractPopupWidget>(WidgetComponent->GetWidget());
+	UWidgetComponent* WidgetComponent = Cast<UWidgetComponent>(AnchorComponent);
 
-	if (ensureAlways(IsValid(Widget)))
+	/**
+	 * Popups are shared and owned by the interaction manager of the local player, so an own popup of the interactable
+	 * would only waste memory. The shared popup is attached to its parent at its location instead. The root component
+	 * can't be destroyed, so it's left as it is.
+	 */
+	if (IsValid(WidgetComponent) && IsValid(WidgetComponent->GetAttachParent()))
 	{
-		HintWidget = Widget;
+		AnchorComponent = WidgetComponent->GetAttachParent();
+		HintWidgetOffset = WidgetComponent->GetRelativeLocation();
+
+		WidgetComponent->DestroyComponent();
 	}
+
+	HintWidgetAnchor = AnchorComponent;
+}
+
+USceneComponent* UInteractableComponent::GetHintWidgetAnchor() const
+{
+	return HintWidgetAnchor.IsValid() ? HintWidgetAnchor.Get() : GetOwner()->GetRootComponent();
 }
 
 void UInteractableComponent::Interact(UInteractionManagerComponent* InteractionManagerComponent) const
@@ -69,28 +180,173 @@ void UInteractableComponent::Interact(UInteractionManagerComponent* InteractionM
 	OnInteract.Broadcast(InteractionManagerComponent);
 }
 
+UInteractionManagerComponent* UInteractableComponent::GetHoldInstigator() const
+{
+	return IsValid(HoldState.Instigator) ? HoldState.Instigator.Get() : nullptr;
+}
+
+double UInteractableComponent::GetServerTime() const
+{
+	const AGameStateBase* GameState = GetWorld()->GetGameState();
+
+	// Clients have their own world time, so the server time synced by the game state is used instead
+	return IsValid(GameState) ? GameState->GetServerWorldTimeSeconds() : GetWorld()->GetTimeSeconds();
+}
+
+double UInteractableComponent::GetHoldElapsedTime() const
+{
+	return GetServerTime() - HoldState.StartServerTime;
+}
+
+float UInteractableComponent::GetHoldProgress() const
+{
+	if (!IsHoldInteraction() || !GetHoldInstigator())
+	{
+		return 0.0f;
+	}
+
+	return FMath::Clamp(GetHoldElapsedTime() / HoldDuration, 0.0, 1.0);
+}
+
+bool UInteractableComponent::StartHold(UInteractionManagerComponent* InteractionManagerComponent)
+{
+#if DO_CHECK
+	check(GetOwner()->HasAuthority());
+#endif
+
+	if (!IsHoldInteraction() || !CanInteract() || !ensureAlways(IsValid(InteractionManagerComponent)))
+	{
+		return false;
+	}
+
+	const UInteractionManagerComponent* CurrentInstigator = GetHoldInstigator();
+
+	if (CurrentInstigator && CurrentInstigator != InteractionManagerComponent &&
+		GetHoldElapsedTime() < HoldDuration + AbandonedHoldTimeout)
+	{
+		INC_DWORD_STAT(STAT_InteractionHoldsRejected);
+
+		return false;
+	}
+
+	INC_DWORD_STAT(STAT_InteractionHoldsStarted);
+	CSV_CUSTOM_STAT(Interaction, HoldsStarted, 1, ECsvCustomStatOp::Accumulate);
+
+	SetHoldState(InteractionManagerComponent, GetServerTime());
+
+	return true;
+}
+
+void UInteractableComponent::StopHold(const UInteractionManagerComponent* InteractionManagerComponent)
+{
+#if DO_CHECK
+	check(GetOwner()->HasAuthority());
+#endif
+
+	if (HoldState.Instigator == InteractionManagerComponent)
+	{
+		SetHoldState(nullptr, 0.0);
+	}
+}
+
+bool UInteractableComponent::CompleteHold(UInteractionManagerComponent* InteractionManagerComponent,
+	const float Tolerance)
+{
+#if DO_CHECK
+	check(GetOwner()->HasAuthority());
+#endif
+
+	if (!IsValid(InteractionManagerComponent) || HoldState.Instigator != InteractionManagerComponent)
+	{
+		INC_DWORD_STAT(STAT_InteractionHoldsRejected);
+
+		return false;
+	}
+
+	// The client can't claim the completion earlier than the hold could be finished since the start on the server
+	const bool bHoldFinished = GetHoldElapsedTime() >= HoldDuration - Tolerance;
+
+	SetHoldState(nullptr, 0.0);
+
+	if (!bHoldFinished || !CanInteract())
+	{
+		INC_DWORD_STAT(STAT_InteractionHoldsRejected);
+
+		return false;
+	}
+
+	INC_DWORD_STAT(STAT_InteractionHoldsCompleted);
+	CSV_CUSTOM_STAT(Interaction, HoldsCompleted, 1, ECsvCustomStatOp::Accumulate);
+
+	Interact(InteractionManagerComponent);
+
+	return true;
+}
+
+void UInteractableComponent::SetHoldState(UInteractionManagerComponent* Instigator, const double StartServerTime)
+{
+	HoldState.Instigator = Instigator;
+	HoldState.StartServerTime = StartServerTime;
+	MARK_PROPERTY_DIRTY_FROM_NAME(ThisClass, HoldState, this);
+
+	// Interactables are usually dormant or rarely updated, so the owner is woken up to send the new state right away
+	AActor* Owner = GetOwner();
+	Owner->FlushNetDormancy();
+	Owner->ForceNetUpdate();
+
+	OnHoldStateChanged.Broadcast(this);
+}
+
+void UInteractableComponent::OnRep_HoldState()
+{
+	OnHoldStateChanged.Broadcast(this);
+}
+
 void UInteractableComponent::SetInteractionHintVisibility(const bool bNewVisibility)
 {
-	// === Set widget hint ===
-	
-	if (HintWidget.IsValid())
+	SCOPE_CYCLE_COUNTER(STAT_InteractionSetHintVisibility);
+	CSV_SCOPED_TIMING_STAT(Interaction, SetHintVisibility);
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(InteractionSetHintVisibility, InteractionChannel);
+
+	/**
+	 * The popup is shown by UInteractionManagerComponent, so only the meshes are hinted here. The meshes aren't
+	 * gathered on headless servers, so there is nothing to do there.
+	 */
+	if (HintMeshes.Num() == 0)
 	{
-		bNewVisibility ? HintWidget->ShowPopup() : HintWidget->HidePopup();
+		return;
 	}
 
-	// === Set mesh hint ===
-	
-	if (HintMeshes.Num() == 0 || !ensureAlways(IsValid(OverlayMaterialHint)))
+	if (bHintUsesCustomDepth)
+	{
+		for (TWeakObjectPtr<UMeshComponent> Mesh : HintMeshes)
+		{
+			if (ensureAlways(Mesh.IsValid()))
+			{
+				INC_DWORD_STAT(STAT_InteractionHintCustomDepthToggles);
+				CSV_CUSTOM_STAT(Interaction, HintCustomDepthToggles, 1, ECsvCustomStatOp::Accumulate);
+
+				Mesh->SetRenderCustomDepth(bNewVisibility);
+			}
+		}
+
+		return;
+	}
+
+	if (!ensureAlways(IsValid(OverlayMaterialHint)))
 	{
 		return;
 	}
-	
+
 	UMaterialInterface* CurrentOverlayMaterial = bNewVisibility ? OverlayMaterialHint : nullptr;
 	
 	for (TWeakObjectPtr<UMeshComponent> Mesh : HintMeshes)
 	{
 		if (ensureAlways(Mesh.IsValid()))
 		{
+			INC_DWORD_STAT(STAT_InteractionHintMaterialSwaps);
+			CSV_CUSTOM_STAT(Interaction, HintMaterialSwaps, 1, ECsvCustomStatOp::Accumulate);
+
 			Mesh->SetOverlayMaterial(CurrentOverlayMaterial);
 		}
 	}
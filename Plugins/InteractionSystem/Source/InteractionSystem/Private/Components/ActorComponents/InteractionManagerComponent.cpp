@@ -3,10 +3,54 @@
 #include "InteractionSystem/Public/Components/ActorComponents/InteractionManagerComponent.h"
 
 #include "Components/ActorComponents/InteractableComponent.h"
+#include "InteractionSystem.h"
+#include "Subsystems/InteractableGridSubsystem.h"
+#include "Widgets/InteractPopupWidget.h"
+
+DECLARE_CYCLE_STAT(TEXT("Interaction Manager Tick"), STAT_InteractionManagerTick, STATGROUP_Interaction);
+DECLARE_CYCLE_STAT(TEXT("Select Interactable"), STAT_InteractionSelect, STATGROUP_Interaction);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Candidate Pool Size"), STAT_InteractionCandidatePoolSize, STATGROUP_Interaction);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Selections"), STAT_InteractionSelections, STATGROUP_Interaction);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Skipped Selections"), STAT_InteractionSkippedSelections, STATGROUP_Interaction);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Line Of Sight Traces"), STAT_InteractionLineOfSightTraces, STATGROUP_Interaction);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Culled Candidates"), STAT_InteractionCulledCandidates, STATGROUP_Interaction);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Line Of Sight Checks"), STAT_InteractionLineOfSightChecks, STATGROUP_Interaction);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Line Of Sight Cache Hits"), STAT_InteractionLineOfSightCacheHits,
+	STATGROUP_Interaction);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Popup Widget Updates"), STAT_InteractionPopupWidgetUpdates, STATGROUP_Interaction);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Direct Interactions"), STAT_InteractionDirectInteractions, STATGROUP_Interaction);
+DECLARE_CYCLE_STAT(TEXT("Find Interactables"), STAT_InteractionFindInteractables, STATGROUP_Interaction);
+DECLARE_CYCLE_STAT(TEXT("Server Validation"), STAT_InteractionServerValidation, STATGROUP_Interaction);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Requests Received"), STAT_InteractionRequestsReceived, STATGROUP_Interaction);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Requests Rate Limited"), STAT_InteractionRequestsRateLimited, STATGROUP_Interaction);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Requests Rejected"), STAT_InteractionRequestsRejected, STATGROUP_Interaction);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Validation Cache Hits"), STAT_InteractionValidationCacheHits, STATGROUP_Interaction);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Validation Traces"), STAT_InteractionValidationTraces, STATGROUP_Interaction);
+
+static TAutoConsoleVariable<bool> CVarChangeDrivenSelection(
+	TEXT("Interaction.ChangeDrivenSelection"),
+	true,
+	TEXT("Whether interaction managers select the interactable only when the view or the candidates change and turn ")
+	TEXT("their tick off when there is nothing to select. Otherwise, the selection is updated every frame."));
+
+static TAutoConsoleVariable<bool> CVarServerValidationLimits(
+	TEXT("Interaction.ServerValidationLimits"),
+	true,
+	TEXT("Whether the server rate-limits interaction requests of every player and reuses recent validation results ")
+	TEXT("instead of tracing for every request."));
+
+static TAutoConsoleVariable<bool> CVarDirectAuthorityInteraction(
+	TEXT("Interaction.DirectAuthorityInteraction"),
+	true,
+	TEXT("Whether interaction managers with the authority (e.g., of bots) interact directly instead of calling the ")
+	TEXT("server RPC and passing its validation."));
 
 UInteractionManagerComponent::UInteractionManagerComponent()
 {
 	PrimaryComponentTick.bCanEverTick = true;
+
+	PopupWidgetClass = TSoftClassPtr<UInteractPopupWidget>(FSoftObjectPath(
+		TEXT("/InteractionSystem/UI/Widgets/InteractionPopups/WBP_InteractionPopup.WBP_InteractionPopup_C")));
 }
 
 void UInteractionManagerComponent::BeginPlay()
@@ -22,93 +66,256 @@ void UInteractionManagerComponent::BeginPlay()
 
 	bIsLocallyControlled = OwningPawn->IsLocallyControlled();
 
+	// Only the locally controlled pawns select interactables, so the others don't need to tick at all
 	if (!bIsLocallyControlled)
 	{
+		SetComponentTickEnabled(false);
+
 		return;
 	}
 		
 	OwnerController = OwningPawn->GetController<APlayerController>();
+	GridSubsystem = GetWorld()->GetSubsystem<UInteractableGridSubsystem>();
+
+#if DO_ENSURE
+	ensureAlways(GridSubsystem.IsValid());
+#endif
+
+	InitializePopupWidgets();
+}
 
-	bool bWasThereCollisionBinding = false;
-	
-	for (USceneComponent* Component : GetAttachChildren())
+void UInteractionManagerComponent::InitializePopupWidgets()
+{
+	const APlayerController* OwningPlayerController = Cast<APlayerController>(OwnerController.Get());
+
+	// Only players see the popups
+	if (!IsValid(OwningPlayerController))
 	{
-		UPrimitiveComponent* Primitive = Cast<UPrimitiveComponent>(Component);
-		
-		if (IsValid(Primitive))
-		{
-			// Add components to the interactable pool on begin overlap and remove them on end overlap
-			Primitive->OnComponentBeginOverlap.AddDynamic(this, &ThisClass::OnAddToInteractableComponentsPool);
-			Primitive->OnComponentEndOverlap.AddDynamic(this, &ThisClass::OnDeleteFromInteractableComponentsPool);
+		return;
+	}
+
+	// It's a small widget loaded once per local player, so it isn't worth showing the first selection without a popup
+	const TSubclassOf<UInteractPopupWidget> LoadedPopupWidgetClass = PopupWidgetClass.LoadSynchronous();
+
+	if (!ensureAlways(LoadedPopupWidgetClass))
+	{
+		return;
+	}
+
+	for (int32 i = 0; i < PopupWidgetsPoolSize; ++i)
+	{
+		UWidgetComponent* PopupWidgetComponent = NewObject<UWidgetComponent>(GetOwner(), NAME_None, RF_Transient);
+
+		PopupWidgetComponent->SetWidgetSpace(PopupWidgetSpace);
+		PopupWidgetComponent->SetDrawAtDesiredSize(true);
+		PopupWidgetComponent->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		PopupWidgetComponent->SetWidgetClass(LoadedPopupWidgetClass);
+		PopupWidgetComponent->SetOwnerPlayer(OwningPlayerController->GetLocalPlayer());
+		PopupWidgetComponent->SetupAttachment(this);
+		PopupWidgetComponent->RegisterComponent();
+
+		PopupWidgetComponents.Add(PopupWidgetComponent);
+	}
+}
+
+void UInteractionManagerComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	GetWorld()->GetTimerManager().ClearTimer(IdleCheckTimerHandle);
+	GetWorld()->GetTimerManager().ClearTimer(HoldTimerHandle);
+
+	// Release the interactable, so somebody else can hold it without waiting for the abandoned hold timeout
+	if (HeldInteractableComponent.IsValid() && GetOwnerRole() == ROLE_Authority)
+	{
+		HeldInteractableComponent->StopHold(this);
+	}
 
-			bWasThereCollisionBinding = true;
+	HeldInteractableComponent = nullptr;
+
+	for (UWidgetComponent* PopupWidgetComponent : PopupWidgetComponents)
+	{
+		if (IsValid(PopupWidgetComponent))
+		{
+			PopupWidgetComponent->DestroyComponent();
 		}
 	}
 
-#if DO_ENSURE
-	ensureAlwaysMsgf(bWasThereCollisionBinding,
-		TEXT("Wasn't there an actor suitable to bind a selection component search!"));
-#endif
+	PopupWidgetComponents.Empty();
+	ShownPopupWidget = nullptr;
+
+	Super::EndPlay(EndPlayReason);
 }
 
 // ReSharper disable once CppParameterMayBeConst
 void UInteractionManagerComponent::TickComponent(float DeltaTime, ELevelTick TickType,
 	FActorComponentTickFunction* ThisTickFunction)
 {
+	SCOPE_CYCLE_COUNTER(STAT_InteractionManagerTick);
+	CSV_SCOPED_TIMING_STAT(Interaction, ManagerTick);
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(InteractionManagerTick, InteractionChannel);
+
+#if CSV_PROFILER
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+#endif
+
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
 	if (bIsLocallyControlled)
 	{
-		SelectInteractableComponent();
+		UpdateSelection();
 	}
-}
 
+#if CSV_PROFILER
+	// Split by players and bots, so the captures show which of them the change-driven selection saves time for
+	const float TickTime = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles);
+	const APawn* OwningPawn = GetOwner<APawn>();
+
+	if (IsValid(OwningPawn) && OwningPawn->IsBotControlled())
+	{
+		CSV_CUSTOM_STAT(Interaction, BotManagerTicks, 1, ECsvCustomStatOp::Accumulate);
+		CSV_CUSTOM_STAT(Interaction, BotManagerTickTime, TickTime, ECsvCustomStatOp::Accumulate);
+	}
+	else
+	{
+		CSV_CUSTOM_STAT(Interaction, PlayerManagerTicks, 1, ECsvCustomStatOp::Accumulate);
+		CSV_CUSTOM_STAT(Interaction, PlayerManagerTickTime, TickTime, ECsvCustomStatOp::Accumulate);
+	}
+#endif
+}
 
-void UInteractionManagerComponent::OnAddToInteractableComponentsPool(UPrimitiveComponent* OverlappedComponent,
-	AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep,
-	const FHitResult& SweepResult)
+void UInteractionManagerComponent::UpdateSelection()
 {
-	if (!IsValid(OtherActor) || OtherActor == GetOwner())
+	if (!ensureAlways(OwnerController.IsValid()))
+	{
+		return;
+	}
+
+	// Find the view location and view rotation
+	FVector ViewLocation;
+	FRotator ViewRotation;
+	OwnerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+
+	// Convert the rotation value to the direction
+	const FVector ViewDirection = ViewRotation.Vector();
+
+	if (!CVarChangeDrivenSelection.GetValueOnGameThread())
 	{
+		UpdateInteractableComponentsPool();
+		SelectInteractableComponent(ViewLocation, ViewDirection);
+		StopHoldIfNotSelected();
+
 		return;
 	}
 
-	// === When the object enters the interaction zone - add it to the pool ===
-	
-	UInteractableComponent* InteractableComponent = OtherActor->FindComponentByClass<UInteractableComponent>();
+	const double CurrentTime = GetWorld()->GetTimeSeconds();
 
-	if (IsValid(InteractableComponent) && InteractableComponent->CanInteract())
+	const bool bFallbackSelectionDue = CurrentTime - LastSelectionTime >= 1.0 / FallbackSelectionRate;
+
+	const bool bViewChanged =
+		FVector::DistSquared(ViewLocation, LastSelectionViewLocation) > FMath::Square(SelectionLocationThreshold) ||
+		FVector::DotProduct(ViewDirection, LastSelectionViewDirection) <
+			FMath::Cos(FMath::DegreesToRadians(SelectionAngleThreshold));
+
+	// Candidates can come and go only when the owner moves or when they move, which is caught by the fallback selection
+	if ((bViewChanged || bFallbackSelectionDue) && UpdateInteractableComponentsPool())
 	{
-		InteractableComponentsPool.Add(InteractableComponent);
+		bSelectionDirty = true;
+	}
+
+	if (!bViewChanged && !bFallbackSelectionDue && !bSelectionDirty)
+	{
+		INC_DWORD_STAT(STAT_InteractionSkippedSelections);
+
+		return;
+	}
+
+	SelectInteractableComponent(ViewLocation, ViewDirection);
+	StopHoldIfNotSelected();
+
+	LastSelectionViewLocation = ViewLocation;
+	LastSelectionViewDirection = ViewDirection;
+	LastSelectionTime = CurrentTime;
+	bSelectionDirty = false;
+
+	// There is nothing to select or wait for, so check for new candidates rarely without ticking
+	if (InteractableComponentsPool.IsEmpty())
+	{
+		SetSelectionIdle(true);
 	}
 }
 
-// ReSharper disable once CppParameterMayBeConstPtrOrRef
-void UInteractionManagerComponent::OnDeleteFromInteractableComponentsPool(UPrimitiveComponent* OverlappedComponent,
-	AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex)
+void UInteractionManagerComponent::SetSelectionIdle(const bool bIdle)
 {
-	if (!IsValid(OtherActor))
+	SetComponentTickEnabled(!bIdle);
+
+	FTimerManager& TimerManager = GetWorld()->GetTimerManager();
+
+	if (bIdle)
 	{
-		return;
+		TimerManager.SetTimer(IdleCheckTimerHandle, this, &ThisClass::OnIdleCheck, IdleCheckInterval, true);
 	}
+	else
+	{
+		TimerManager.ClearTimer(IdleCheckTimerHandle);
 
-	// === When the object leaves the zone - remove it from the pool ===
-	
-	UInteractableComponent* InteractableComponent = OtherActor->FindComponentByClass<UInteractableComponent>();
+		bSelectionDirty = true;
+	}
+}
 
-	if (!IsValid(InteractableComponent))
+void UInteractionManagerComponent::OnIdleCheck()
+{
+	if (!CVarChangeDrivenSelection.GetValueOnGameThread() || UpdateInteractableComponentsPool())
 	{
-		return;
+		SetSelectionIdle(false);
 	}
+}
 
-	// Remove hint if item was selected
-	if (SelectedInteractableComponent == InteractableComponent)
+bool UInteractionManagerComponent::UpdateInteractableComponentsPool()
+{
+	if (!GridSubsystem.IsValid())
 	{
-		SelectedInteractableComponent->SetInteractionHintVisibility(false);
-		SelectedInteractableComponent = nullptr;
+		return false;
 	}
-		
-	InteractableComponentsPool.Remove(InteractableComponent);
+
+	const AActor* Owner = GetOwner();
+
+	GridSubsystem->FindInteractablesInRadius(Owner->GetActorLocation(), MaxInteractionDistance,
+		FoundInteractableComponents);
+
+	// Keep the previous pool to find out whether it was changed
+	Swap(InteractableComponentsPool, PreviousInteractableComponentsPool);
+	InteractableComponentsPool.Reset();
+
+	for (UInteractableComponent* InteractableComponent : FoundInteractableComponents)
+	{
+		const AActor* InteractableActor = InteractableComponent->GetOwner();
+
+		// Hidden actors (e.g., pooled pickups) can't be interacted with even if they are still registered in the grid
+		if (InteractableActor != Owner && !InteractableActor->IsHidden() && InteractableComponent->CanInteract())
+		{
+			InteractableComponentsPool.Add(InteractableComponent);
+		}
+	}
+
+	// Forget the line-of-sight results of the interactables that left the pool
+	for (auto It = LineOfSightCache.CreateIterator(); It; ++It)
+	{
+		if (!InteractableComponentsPool.Contains(It.Key().ResolveObjectPtr()))
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	// Remove hint if the selected item left the pool
+	if (SelectedInteractableComponent.IsValid() &&
+		!InteractableComponentsPool.Contains(SelectedInteractableComponent))
+	{
+		SetSelectedInteractableComponent(nullptr);
+	}
+
+	SET_DWORD_STAT(STAT_InteractionCandidatePoolSize, InteractableComponentsPool.Num());
+	CSV_CUSTOM_STAT(Interaction, CandidatePoolSize, InteractableComponentsPool.Num(), ECsvCustomStatOp::Set);
+
+	return InteractableComponentsPool != PreviousInteractableComponentsPool;
 }
 
 bool UInteractionManagerComponent::IsPathObstructed(const UInteractableComponent* InteractableComponent) const
@@ -123,38 +330,110 @@ bool UInteractionManagerComponent::IsPathObstructed(const UInteractableComponent
 	const FVector Start = GetOwner()->GetActorLocation();
 	const FVector End = InteractableActor->GetActorLocation();
 
-	FCollisionQueryParams TraceParams;
+	FHitResult HitResult;
+	return GetWorld()->LineTraceSingleByChannel(HitResult, Start, End, ECC_Visibility,
+		GetLineOfSightTraceParams(InteractableActor));
+}
+
+FCollisionQueryParams UInteractionManagerComponent::GetLineOfSightTraceParams(const AActor* InteractableActor) const
+{
+	FCollisionQueryParams TraceParams(SCENE_QUERY_STAT(InteractionLineOfSight), true);
 	TraceParams.AddIgnoredActor(GetOwner());
 	TraceParams.AddIgnoredActor(InteractableActor);
-	TraceParams.bTraceComplex = true;
 
-	FHitResult HitResult;
-	return GetWorld()->LineTraceSingleByChannel(HitResult, Start, End, ECC_Visibility, TraceParams);
+	return TraceParams;
+}
+
+bool UInteractionManagerComponent::HasCachedLineOfSight(const UInteractableComponent* InteractableComponent,
+	const FVector& ViewerLocation)
+{
+	const AActor* InteractableActor = InteractableComponent->GetOwner();
+	const FVector InteractableLocation = InteractableActor->GetActorLocation();
+
+	FLineOfSightCacheEntry& CacheEntry = LineOfSightCache.FindOrAdd(InteractableComponent);
+
+	const float ThresholdSquared = FMath::Square(LineOfSightCacheDistanceThreshold);
+
+	const bool bCacheOutdated = !CacheEntry.bHasResult ||
+		FVector::DistSquared(CacheEntry.ViewerLocation, ViewerLocation) > ThresholdSquared ||
+		FVector::DistSquared(CacheEntry.InteractableLocation, InteractableLocation) > ThresholdSquared;
+
+	if (!bCacheOutdated)
+	{
+		INC_DWORD_STAT(STAT_InteractionLineOfSightCacheHits);
+	}
+	else if (!CacheEntry.bTracePending)
+	{
+		INC_DWORD_STAT(STAT_InteractionLineOfSightTraces);
+		CSV_CUSTOM_STAT(Interaction, LineOfSightTraces, 1, ECsvCustomStatOp::Accumulate);
+
+		// All traces requested during the frame are processed together and their results are read in the next frame
+		CacheEntry.TraceHandle = GetWorld()->AsyncLineTraceByChannel(EAsyncTraceType::Single, ViewerLocation,
+			InteractableLocation, ECC_Visibility, GetLineOfSightTraceParams(InteractableActor),
+			FCollisionResponseParams::DefaultResponseParam,
+			FTraceDelegate::CreateUObject(this, &ThisClass::OnLineOfSightTraceDone,
+				TObjectKey<UInteractableComponent>(InteractableComponent)));
+
+		CacheEntry.ViewerLocation = ViewerLocation;
+		CacheEntry.InteractableLocation = InteractableLocation;
+		CacheEntry.bTracePending = true;
+	}
+
+	return CacheEntry.bHasResult && !CacheEntry.bObstructed;
+}
+
+// ReSharper disable once CppParameterMayBeConstPtrOrRef
+void UInteractionManagerComponent::OnLineOfSightTraceDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum,
+	TObjectKey<UInteractableComponent> InteractableComponentKey)
+{
+	FLineOfSightCacheEntry* CacheEntry = LineOfSightCache.Find(InteractableComponentKey);
+
+	// The interactable could leave the pool while the trace was pending
+	if (!CacheEntry || CacheEntry->TraceHandle != TraceHandle)
+	{
+		return;
+	}
+
+	const bool bObstructed = FHitResult::GetFirstBlockingHit(TraceDatum.OutHits) != nullptr;
+
+	// The selection depends on the line of sight, so it has to be updated if the result was changed
+	if (!CacheEntry->bHasResult || CacheEntry->bObstructed != bObstructed)
+	{
+		bSelectionDirty = true;
+	}
+
+	CacheEntry->bTracePending = false;
+	CacheEntry->bHasResult = true;
+	CacheEntry->bObstructed = bObstructed;
 }
 
-void UInteractionManagerComponent::SelectInteractableComponent()
+void UInteractionManagerComponent::SelectInteractableComponent(const FVector& ViewLocation,
+	const FVector& ViewDirection)
 {
-	if (!ensureAlways(OwnerController.IsValid()) || InteractableComponentsPool.IsEmpty())
+	SCOPE_CYCLE_COUNTER(STAT_InteractionSelect);
+	CSV_SCOPED_TIMING_STAT(Interaction, SelectInteractable);
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(InteractionSelectInteractable, InteractionChannel);
+	INC_DWORD_STAT(STAT_InteractionSelections);
+	CSV_CUSTOM_STAT(Interaction, Selections, 1, ECsvCustomStatOp::Accumulate);
+
+	if (InteractableComponentsPool.IsEmpty())
 	{
 		return;
 	}
-	
-	// Find the view location and view rotation
-	FVector ViewLocation;
-	FRotator ViewRotation;
-	OwnerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
 
-	// Convert the rotation value to the direction
-	const FVector ViewDirection = ViewRotation.Vector();
+	const FVector OwnerLocation = GetOwner()->GetActorLocation();
 
-	// === Select a new InteractableComponent ===
-	
-	UInteractableComponent* NewSelectedInteractableComponent = nullptr;
-	float BestDotProduct = -1.0f;
+	// === Rank the candidates by a cheap score and cull the ones outside the view cone ===
+
+	const float MinDotProduct = FMath::Cos(FMath::DegreesToRadians(SelectionConeHalfAngle));
+
+	RankedCandidates.Reset();
+
+	bool bSelectedCandidateCulled = true;
 
 	for (TWeakObjectPtr<UInteractableComponent> InteractableComponent : InteractableComponentsPool)
 	{
-		if (!IsValid(InteractableComponent.Get()) || IsPathObstructed(InteractableComponent.Get()))
+		if (!IsValid(InteractableComponent.Get()))
 		{
 			continue;
 		}
@@ -162,31 +441,139 @@ void UInteractionManagerComponent::SelectInteractableComponent()
 		const FVector OffsetVectorToActor = InteractableComponent->GetOwner()->GetActorLocation() - ViewLocation;
 		const FVector DirectionToActor = OffsetVectorToActor.GetSafeNormal();
 
+		// The closer to 1.0, the more accurate the ViewDirection of DirectionToActor
 		const float DotProduct = FVector::DotProduct(ViewDirection, DirectionToActor);
 
-		// The closer to 1.0, the more accurate the ViewDirection of DirectionToActor
-		if (DotProduct > BestDotProduct) 
+		if (DotProduct < MinDotProduct)
 		{
-			BestDotProduct = DotProduct;
+			INC_DWORD_STAT(STAT_InteractionCulledCandidates);
 
-			NewSelectedInteractableComponent = InteractableComponent.Get();
+			continue;
 		}
+
+		if (InteractableComponent == SelectedInteractableComponent)
+		{
+			bSelectedCandidateCulled = false;
+		}
+
+		// Prefer closer candidates when they are at about the same angle
+		const float DistanceFactor = OffsetVectorToActor.Size() / FMath::Max(MaxInteractionDistance, 1.0f);
+
+		RankedCandidates.Add({ InteractableComponent.Get(), DotProduct - SelectionDistanceWeight * DistanceFactor });
+	}
+
+	RankedCandidates.Sort([](const FSelectionCandidate& A, const FSelectionCandidate& B)
+	{
+		return A.Score > B.Score;
+	});
+
+	// === Select the best candidate in the line of sight among the top ones ===
+
+	UInteractableComponent* NewSelectedInteractableComponent = nullptr;
+
+	// Only the top candidates are checked, so the number of traces per selection is capped
+	const int32 CheckedCandidatesNumber = FMath::Min(RankedCandidates.Num(), MaxLineOfSightChecks);
+
+	for (int32 i = 0; i < CheckedCandidatesNumber; ++i)
+	{
+		INC_DWORD_STAT(STAT_InteractionLineOfSightChecks);
+		CSV_CUSTOM_STAT(Interaction, LineOfSightChecks, 1, ECsvCustomStatOp::Accumulate);
+
+		UInteractableComponent* Candidate = RankedCandidates[i].InteractableComponent;
+
+		if (HasCachedLineOfSight(Candidate, OwnerLocation))
+		{
+			NewSelectedInteractableComponent = Candidate;
+
+			break;
+		}
+
+		/**
+		 * The line of sight of a better candidate isn't known until its first trace is done, so the current selection
+		 * is kept instead of switching to a worse candidate for a frame. The trace result marks the selection dirty.
+		 */
+		if (!LineOfSightCache.FindChecked(Candidate).bHasResult)
+		{
+			break;
+		}
+	}
+
+	// Nobody should interact with what is outside the view cone, so drop the selection of such a candidate
+	if (!NewSelectedInteractableComponent && bSelectedCandidateCulled && SelectedInteractableComponent.IsValid())
+	{
+		SetSelectedInteractableComponent(nullptr);
 	}
-	
+
 	if (!NewSelectedInteractableComponent || NewSelectedInteractableComponent == SelectedInteractableComponent)
 	{
 		return;
 	}
 
+	SetSelectedInteractableComponent(NewSelectedInteractableComponent);
+}
+
+void UInteractionManagerComponent::SetSelectedInteractableComponent(
+	UInteractableComponent* NewSelectedInteractableComponent)
+{
 	// Remove selection from the old selected actor
 	if (SelectedInteractableComponent.IsValid())
 	{
 		SelectedInteractableComponent->SetInteractionHintVisibility(false);
-		SelectedInteractableComponent = nullptr;
+		HidePopupWidget();
 	}
-	
+
 	SelectedInteractableComponent = NewSelectedInteractableComponent;
-	SelectedInteractableComponent->SetInteractionHintVisibility(true);
+
+	if (IsValid(NewSelectedInteractableComponent))
+	{
+		NewSelectedInteractableComponent->SetInteractionHintVisibility(true);
+		ShowPopupWidget(NewSelectedInteractableComponent);
+	}
+}
+
+void UInteractionManagerComponent::ShowPopupWidget(const UInteractableComponent* InteractableComponent)
+{
+	if (PopupWidgetComponents.IsEmpty())
+	{
+		return;
+	}
+
+	// The previous popup may still play its hide animation, so the next one from the pool is used
+	UWidgetComponent* PopupWidgetComponent = PopupWidgetComponents[NextPopupWidgetIndex];
+	NextPopupWidgetIndex = (NextPopupWidgetIndex + 1) % PopupWidgetComponents.Num();
+
+	UInteractPopupWidget* PopupWidget = Cast<UInteractPopupWidget>(PopupWidgetComponent->GetWidget());
+
+	if (!ensureAlways(IsValid(PopupWidget)))
+	{
+		return;
+	}
+
+	PopupWidgetComponent->AttachToComponent(InteractableComponent->GetHintWidgetAnchor(),
+		FAttachmentTransformRules::SnapToTargetNotIncludingScale);
+
+	PopupWidgetComponent->SetRelativeLocation(InteractableComponent->GetHintWidgetOffset());
+
+	INC_DWORD_STAT(STAT_InteractionPopupWidgetUpdates);
+	CSV_CUSTOM_STAT(Interaction, PopupWidgetUpdates, 1, ECsvCustomStatOp::Accumulate);
+
+	PopupWidget->ShowPopup();
+
+	ShownPopupWidget = PopupWidget;
+}
+
+void UInteractionManagerComponent::HidePopupWidget()
+{
+	if (!ShownPopupWidget.IsValid())
+	{
+		return;
+	}
+
+	INC_DWORD_STAT(STAT_InteractionPopupWidgetUpdates);
+	CSV_CUSTOM_STAT(Interaction, PopupWidgetUpdates, 1, ECsvCustomStatOp::Accumulate);
+
+	ShownPopupWidget->HidePopup();
+	ShownPopupWidget = nullptr;
 }
 
 bool UInteractionManagerComponent::TryInteract()
@@ -205,32 +592,375 @@ bool UInteractionManagerComponent::TryInteract(UInteractableComponent* Interacta
 	}
 #endif
 
-	if (IsValid(InteractableComponent))
+	if (!IsValid(InteractableComponent))
 	{
-		Server_TryInteract(InteractableComponent);
+		return false;
+	}
+
+	if (InteractableComponent->IsHoldInteraction())
+	{
+		return StartHoldInteraction(InteractableComponent);
+	}
 
-		return true;
+	// The server trusts itself, so there is no need to go through the RPC and its validation
+	if (ShouldInteractAsAuthority())
+	{
+		return InteractAsAuthority(InteractableComponent);
 	}
 
-	return false;
+	Server_TryInteract(InteractableComponent);
+
+	return true;
 }
 
-void UInteractionManagerComponent::Server_TryInteract_Implementation(UInteractableComponent* InteractableComponent)
+bool UInteractionManagerComponent::ShouldInteractAsAuthority() const
+{
+	return GetOwnerRole() == ROLE_Authority && CVarDirectAuthorityInteraction.GetValueOnGameThread();
+}
+
+bool UInteractionManagerComponent::IsWithinInteractionDistance(
+	const UInteractableComponent* InteractableComponent) const
+{
+	const FVector InteractableComponentLocation = InteractableComponent->GetOwner()->GetActorLocation();
+	const FVector OwnerLocation = GetOwner()->GetActorLocation();
+
+	return FVector::DistSquared(InteractableComponentLocation, OwnerLocation) <= FMath::Square(MaxInteractionDistance);
+}
+
+bool UInteractionManagerComponent::StartHoldInteraction(UInteractableComponent* InteractableComponent)
+{
+	if (!IsValid(InteractableComponent) || !ensureAlways(InteractableComponent->IsHoldInteraction()))
+	{
+		return false;
+	}
+
+	StopHoldInteraction();
+
+	if (ShouldInteractAsAuthority())
+	{
+		if (!InteractableComponent->CanInteract() || !IsWithinInteractionDistance(InteractableComponent) ||
+			!InteractableComponent->StartHold(this))
+		{
+			return false;
+		}
+	}
+	else
+	{
+		Server_StartHoldInteraction(InteractableComponent);
+	}
+
+	HeldInteractableComponent = InteractableComponent;
+
+	/**
+	 * The hold is started on the server about half of the round trip later, and the completion arrives there about half
+	 * of the round trip after the timer, so the server sees the same duration
+	 */
+	GetWorld()->GetTimerManager().SetTimer(HoldTimerHandle, this, &ThisClass::OnHoldTimerFinished,
+		InteractableComponent->GetHoldDuration(), false);
+
+	return true;
+}
+
+void UInteractionManagerComponent::StopHoldInteraction()
+{
+	GetWorld()->GetTimerManager().ClearTimer(HoldTimerHandle);
+
+	UInteractableComponent* InteractableComponent = HeldInteractableComponent.Get();
+	HeldInteractableComponent = nullptr;
+
+	if (!IsValid(InteractableComponent))
+	{
+		return;
+	}
+
+	if (ShouldInteractAsAuthority())
+	{
+		InteractableComponent->StopHold(this);
+	}
+	else
+	{
+		Server_StopHoldInteraction(InteractableComponent);
+	}
+}
+
+void UInteractionManagerComponent::StopHoldIfNotSelected()
+{
+	if (HeldInteractableComponent.IsValid() && HeldInteractableComponent != SelectedInteractableComponent)
+	{
+		StopHoldInteraction();
+	}
+}
+
+void UInteractionManagerComponent::OnHoldTimerFinished()
+{
+	UInteractableComponent* InteractableComponent = HeldInteractableComponent.Get();
+	HeldInteractableComponent = nullptr;
+
+	if (!IsValid(InteractableComponent))
+	{
+		return;
+	}
+
+	if (!ShouldInteractAsAuthority())
+	{
+		Server_CompleteHoldInteraction(InteractableComponent);
+	}
+	else if (IsWithinInteractionDistance(InteractableComponent))
+	{
+		InteractableComponent->CompleteHold(this, HoldCompletionTolerance);
+	}
+	else
+	{
+		InteractableComponent->StopHold(this);
+	}
+}
+
+bool UInteractionManagerComponent::InteractAsAuthority(UInteractableComponent* InteractableComponent)
 {
+#if DO_ENSURE
+	ensureAlways(GetOwnerRole() == ROLE_Authority);
+#endif
+
+	// Hidden actors are never selected, so they can't be interacted with directly either
+	if (!IsValid(InteractableComponent) || InteractableComponent->GetOwner()->IsHidden() ||
+		!InteractableComponent->CanInteract() || !IsWithinInteractionDistance(InteractableComponent))
+	{
+		return false;
+	}
+
+	INC_DWORD_STAT(STAT_InteractionDirectInteractions);
+	CSV_CUSTOM_STAT(Interaction, DirectInteractions, 1, ECsvCustomStatOp::Accumulate);
+
 	InteractableComponent->Interact(this);
+
+	return true;
+}
+
+void UInteractionManagerComponent::FindInteractables(const FGameplayTag& Tag, const float MaxDistance,
+	TArray<UInteractableComponent*>& OutInteractables) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_InteractionFindInteractables);
+	CSV_SCOPED_TIMING_STAT(Interaction, FindInteractables);
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(InteractionFindInteractables, InteractionChannel);
+
+	OutInteractables.Reset();
+
+	// Bots aren't locally controlled when they begin play, so they don't have the cached subsystem
+	const UInteractableGridSubsystem* InteractableGridSubsystem =
+		GetWorld()->GetSubsystem<UInteractableGridSubsystem>();
+
+	if (!ensureAlways(IsValid(InteractableGridSubsystem)))
+	{
+		return;
+	}
+
+	const AActor* Owner = GetOwner();
+	const FVector OwnerLocation = Owner->GetActorLocation();
+
+	InteractableGridSubsystem->FindInteractablesInRadius(OwnerLocation, MaxDistance, OutInteractables);
+
+	OutInteractables.RemoveAllSwap([Owner, &Tag](const UInteractableComponent* InteractableComponent)
+	{
+		return InteractableComponent->GetOwner() == Owner || InteractableComponent->GetOwner()->IsHidden() ||
+			!InteractableComponent->CanInteract() ||
+			(Tag.IsValid() && !InteractableComponent->GetInteractionTags().HasTag(Tag));
+	}, EAllowShrinking::No);
+
+	OutInteractables.Sort([&OwnerLocation](const UInteractableComponent& A, const UInteractableComponent& B)
+	{
+		return FVector::DistSquared(A.GetOwner()->GetActorLocation(), OwnerLocation) <
+			FVector::DistSquared(B.GetOwner()->GetActorLocation(), OwnerLocation);
+	});
+}
+
+UInteractableComponent* UInteractionManagerComponent::FindNearestInteractable(const FGameplayTag& Tag,
+	const float MaxDistance) const
+{
+	TArray<UInteractableComponent*> FoundInteractables;
+	FindInteractables(Tag, MaxDistance, FoundInteractables);
+
+	return FoundInteractables.IsEmpty() ? nullptr : FoundInteractables[0];
+}
+
+void UInteractionManagerComponent::Server_TryInteract_Implementation(UInteractableComponent* InteractableComponent)
+{
+	INC_DWORD_STAT(STAT_InteractionRequestsReceived);
+	CSV_CUSTOM_STAT(Interaction, RequestsReceived, 1, ECsvCustomStatOp::Accumulate);
+
+	if (ValidateServerInteraction(InteractableComponent))
+	{
+		InteractableComponent->Interact(this);
+	}
+}
+
+void UInteractionManagerComponent::Server_StartHoldInteraction_Implementation(
+	UInteractableComponent* InteractableComponent)
+{
+	INC_DWORD_STAT(STAT_InteractionRequestsReceived);
+	CSV_CUSTOM_STAT(Interaction, RequestsReceived, 1, ECsvCustomStatOp::Accumulate);
+
+	if (!ValidateServerInteraction(InteractableComponent) || !InteractableComponent->IsHoldInteraction())
+	{
+		return;
+	}
+
+	// Release the previous hold in case its stop request was dropped
+	if (HeldInteractableComponent.IsValid() && HeldInteractableComponent != InteractableComponent)
+	{
+		HeldInteractableComponent->StopHold(this);
+	}
+
+	HeldInteractableComponent = InteractableComponent->StartHold(this) ? InteractableComponent : nullptr;
+}
+
+void UInteractionManagerComponent::Server_StopHoldInteraction_Implementation(
+	UInteractableComponent* InteractableComponent)
+{
+	if (HeldInteractableComponent == InteractableComponent)
+	{
+		HeldInteractableComponent = nullptr;
+	}
+
+	if (IsValid(InteractableComponent))
+	{
+		InteractableComponent->StopHold(this);
+	}
+}
+
+void UInteractionManagerComponent::Server_CompleteHoldInteraction_Implementation(
+	UInteractableComponent* InteractableComponent)
+{
+	if (HeldInteractableComponent == InteractableComponent)
+	{
+		HeldInteractableComponent = nullptr;
+	}
+
+	if (!IsValid(InteractableComponent))
+	{
+		return;
+	}
+
+	// The line of sight was validated at the start, but the owner could walk away while holding
+	if (!IsWithinInteractionDistance(InteractableComponent))
+	{
+		InteractableComponent->StopHold(this);
+
+		return;
+	}
+
+	InteractableComponent->CompleteHold(this, HoldCompletionTolerance);
 }
 
-bool UInteractionManagerComponent::Server_TryInteract_Validate(UInteractableComponent* InteractableComponent)
+bool UInteractionManagerComponent::ValidateServerInteraction(const UInteractableComponent* InteractableComponent)
 {
+	SCOPE_CYCLE_COUNTER(STAT_InteractionServerValidation);
+	CSV_SCOPED_TIMING_STAT(Interaction, ServerValidation);
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(InteractionServerValidation, InteractionChannel);
+
+	const bool bValidationLimits = CVarServerValidationLimits.GetValueOnGameThread();
+
+	// Excess requests are dropped before any other check, so flooding the server doesn't cost traces
+	if (bValidationLimits && !ConsumeInteractionRequestToken())
+	{
+		INC_DWORD_STAT(STAT_InteractionRequestsRateLimited);
+		CSV_CUSTOM_STAT(Interaction, RequestsRateLimited, 1, ECsvCustomStatOp::Accumulate);
+
+		return false;
+	}
+
 	if (!IsValid(InteractableComponent) || !InteractableComponent->CanInteract())
 	{
+		INC_DWORD_STAT(STAT_InteractionRequestsRejected);
+		CSV_CUSTOM_STAT(Interaction, RequestsRejected, 1, ECsvCustomStatOp::Accumulate);
+
 		return false;
 	}
 
 	const FVector InteractableComponentLocation = InteractableComponent->GetOwner()->GetActorLocation();
 	const FVector OwnerLocation = GetOwner()->GetActorLocation();
+	const double CurrentTime = GetWorld()->GetTimeSeconds();
+
+	const float ThresholdSquared = FMath::Square(ValidationCacheDistanceThreshold);
+
+	if (bValidationLimits)
+	{
+		const FValidatedInteraction* ValidatedInteraction = ValidatedInteractions.Find(InteractableComponent);
+
+		if (ValidatedInteraction && ValidatedInteraction->ExpirationTime >= CurrentTime &&
+			FVector::DistSquared(ValidatedInteraction->InstigatorLocation, OwnerLocation) <= ThresholdSquared &&
+			FVector::DistSquared(ValidatedInteraction->InteractableLocation, InteractableComponentLocation) <=
+				ThresholdSquared)
+		{
+			INC_DWORD_STAT(STAT_InteractionValidationCacheHits);
+
+			return true;
+		}
+	}
 
 	const float DistanceToInteractableComponent = FVector::Distance(InteractableComponentLocation, OwnerLocation);
 
-	return DistanceToInteractableComponent <= MaxInteractionDistance && !IsPathObstructed(InteractableComponent);
+	if (DistanceToInteractableComponent > MaxInteractionDistance)
+	{
+		INC_DWORD_STAT(STAT_InteractionRequestsRejected);
+		CSV_CUSTOM_STAT(Interaction, RequestsRejected, 1, ECsvCustomStatOp::Accumulate);
+
+		return false;
+	}
+
+	INC_DWORD_STAT(STAT_InteractionValidationTraces);
+	CSV_CUSTOM_STAT(Interaction, ValidationTraces, 1, ECsvCustomStatOp::Accumulate);
+
+	if (IsPathObstructed(InteractableComponent))
+	{
+		INC_DWORD_STAT(STAT_InteractionRequestsRejected);
+		CSV_CUSTOM_STAT(Interaction, RequestsRejected, 1, ECsvCustomStatOp::Accumulate);
+
+		return false;
+	}
+
+	if (bValidationLimits)
+	{
+		// Forget the expired interactions, so the cache doesn't grow with every interactable the owner used
+		for (auto It = ValidatedInteractions.CreateIterator(); It; ++It)
+		{
+			if (It.Value().ExpirationTime < CurrentTime)
+			{
+				It.RemoveCurrent();
+			}
+		}
+
+		ValidatedInteractions.Add(InteractableComponent,
+			{ CurrentTime + ValidationCacheDuration, OwnerLocation, InteractableComponentLocation });
+	}
+
+	return true;
+}
+
+bool UInteractionManagerComponent::ConsumeInteractionRequestToken()
+{
+	const double CurrentTime = GetWorld()->GetRealTimeSeconds();
+
+	// The bucket starts full
+	if (LastInteractionRequestTokensUpdateTime < 0.0)
+	{
+		InteractionRequestTokens = InteractionRequestsBurst;
+	}
+	else
+	{
+		const double ElapsedTime = CurrentTime - LastInteractionRequestTokensUpdateTime;
+
+		InteractionRequestTokens = FMath::Min(InteractionRequestsBurst,
+			InteractionRequestTokens + ElapsedTime * InteractionRequestsRate);
+	}
+
+	LastInteractionRequestTokensUpdateTime = CurrentTime;
+
+	if (InteractionRequestTokens < 1.0f)
+	{
+		return false;
+	}
+
+	InteractionRequestTokens -= 1.0f;
+
+	return true;
 }
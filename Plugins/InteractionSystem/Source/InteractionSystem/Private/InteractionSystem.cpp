@@ -4,6 +4,12 @@
 
 #define LOCTEXT_NAMESPACE "FInteractionSystemModule"
 
+DEFINE_LOG_CATEGORY(LogInteractionSystem);
+
+CSV_DEFINE_CATEGORY_MODULE(INTERACTIONSYSTEM_API, Interaction, true);
+
+UE_TRACE_CHANNEL_DEFINE(InteractionChannel);
+
 void FInteractionSystemModule::StartupModule()
 {
 	// This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file per-module
@@ -0,0 +1,193 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Subsystems/InteractableGridSubsystem.h"
+
+#include "InteractionSystem.h"
+#include "Components/ActorComponents/InteractableComponent.h"
+
+DECLARE_CYCLE_STAT(TEXT("Grid Query"), STAT_InteractionGridQuery, STATGROUP_Interaction);
+DECLARE_CYCLE_STAT(TEXT("Grid Update"), STAT_InteractionGridUpdate, STATGROUP_Interaction);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Grid Interactables"), STAT_InteractionGridInteractables, STATGROUP_Interaction);
+
+void UInteractableGridSubsystem::Deinitialize()
+{
+	SET_DWORD_STAT(STAT_InteractionGridInteractables, 0);
+
+	Cells.Empty();
+	CellsByInteractable.Empty();
+
+	Super::Deinitialize();
+}
+
+FIntVector UInteractableGridSubsystem::GetCellCoordinates(const FVector& Location) const
+{
+	return FIntVector(FMath::FloorToInt32(Location.X / CellSize), FMath::FloorToInt32(Location.Y / CellSize),
+		FMath::FloorToInt32(Location.Z / CellSize));
+}
+
+void UInteractableGridSubsystem::RegisterInteractable(UInteractableComponent* InteractableComponent)
+{
+#if DO_CHECK
+	check(IsValid(InteractableComponent));
+	check(IsValid(InteractableComponent->GetOwner()));
+#endif
+
+	if (!ensureAlways(!CellsByInteractable.Contains(InteractableComponent)))
+	{
+		return;
+	}
+
+	const FVector Location = InteractableComponent->GetOwner()->GetActorLocation();
+
+	AddEntry(InteractableComponent, Location, GetCellCoordinates(Location));
+
+	SET_DWORD_STAT(STAT_InteractionGridInteractables, CellsByInteractable.Num());
+}
+
+void UInteractableGridSubsystem::UnregisterInteractable(const UInteractableComponent* InteractableComponent)
+{
+	FIntVector Cell;
+
+	if (CellsByInteractable.RemoveAndCopyValue(InteractableComponent, Cell))
+	{
+		RemoveEntry(InteractableComponent, Cell);
+
+		SET_DWORD_STAT(STAT_InteractionGridInteractables, CellsByInteractable.Num());
+	}
+}
+
+void UInteractableGridSubsystem::UpdateInteractableLocation(UInteractableComponent* InteractableComponent)
+{
+	SCOPE_CYCLE_COUNTER(STAT_InteractionGridUpdate);
+	CSV_SCOPED_TIMING_STAT(Interaction, GridUpdate);
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(InteractionGridUpdate, InteractionChannel);
+
+#if DO_CHECK
+	check(IsValid(InteractableComponent));
+	check(IsValid(InteractableComponent->GetOwner()));
+#endif
+
+	const FIntVector* OldCell = CellsByInteractable.Find(InteractableComponent);
+
+	if (!OldCell)
+	{
+		return;
+	}
+
+	const FVector Location = InteractableComponent->GetOwner()->GetActorLocation();
+	const FIntVector NewCell = GetCellCoordinates(Location);
+
+	// Most of the moves don't leave the cell, so only the cached location has to be updated
+	if (NewCell == *OldCell)
+	{
+		for (FGridEntry& Entry : Cells.FindChecked(NewCell))
+		{
+			if (Entry.InteractableComponent.HasSameIndexAndSerialNumber(InteractableComponent))
+			{
+				Entry.Location = Location;
+
+				break;
+			}
+		}
+
+		return;
+	}
+
+	RemoveEntry(InteractableComponent, *OldCell);
+	AddEntry(InteractableComponent, Location, NewCell);
+}
+
+void UInteractableGridSubsystem::AddEntry(UInteractableComponent* InteractableComponent, const FVector& Location,
+	const FIntVector& Cell)
+{
+	Cells.FindOrAdd(Cell).Add({ InteractableComponent, Location });
+	CellsByInteractable.Add(InteractableComponent, Cell);
+}
+
+void UInteractableGridSubsystem::RemoveEntry(const UInteractableComponent* InteractableComponent,
+	const FIntVector& Cell)
+{
+	TArray<FGridEntry>* Entries = Cells.Find(Cell);
+
+	if (!ensureAlways(Entries))
+	{
+		return;
+	}
+
+	// Compare the indices instead of the pointers because the component could be already marked as garbage
+	const int32 EntryIndex = Entries->IndexOfByPredicate([InteractableComponent](const FGridEntry& Entry)
+	{
+		return Entry.InteractableComponent.HasSameIndexAndSerialNumber(InteractableComponent);
+	});
+
+	if (ensureAlways(EntryIndex != INDEX_NONE))
+	{
+		Entries->RemoveAtSwap(EntryIndex, 1, EAllowShrinking::No);
+	}
+
+	if (Entries->IsEmpty())
+	{
+		Cells.Remove(Cell);
+	}
+}
+
+void UInteractableGridSubsystem::FindInteractablesInRadius(const FVector& Point, const float Radius,
+	TArray<UInteractableComponent*>& OutInteractables) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_InteractionGridQuery);
+	CSV_SCOPED_TIMING_STAT(Interaction, GridQuery);
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(InteractionGridQuery, InteractionChannel);
+
+	OutInteractables.Reset();
+
+	const float RadiusSquared = FMath::Square(Radius);
+
+	const auto GatherEntries = [&Point, RadiusSquared, &OutInteractables](const TArray<FGridEntry>& Entries)
+	{
+		for (const FGridEntry& Entry : Entries)
+		{
+			if (FVector::DistSquared(Entry.Location, Point) > RadiusSquared)
+			{
+				continue;
+			}
+
+			UInteractableComponent* InteractableComponent = Entry.InteractableComponent.Get();
+
+			if (IsValid(InteractableComponent))
+			{
+				OutInteractables.Add(InteractableComponent);
+			}
+		}
+	};
+
+	const FIntVector MinCell = GetCellCoordinates(Point - FVector(Radius));
+	const FIntVector MaxCell = GetCellCoordinates(Point + FVector(Radius));
+
+	const int64 BoxCellsNumber = static_cast<int64>(MaxCell.X - MinCell.X + 1) * (MaxCell.Y - MinCell.Y + 1) *
+		(MaxCell.Z - MinCell.Z + 1);
+
+	// A huge radius would visit mostly empty cells, so it's cheaper to check all occupied cells instead
+	if (BoxCellsNumber > Cells.Num())
+	{
+		for (const TPair<FIntVector, TArray<FGridEntry>>& Cell : Cells)
+		{
+			GatherEntries(Cell.Value);
+		}
+
+		return;
+	}
+
+	for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+	{
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+		{
+			for (int32 Z = MinCell.Z; Z <= MaxCell.Z; ++Z)
+			{
+				if (const TArray<FGridEntry>* Entries = Cells.Find(FIntVector(X, Y, Z)))
+				{
+					GatherEntries(*Entries);
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,26 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "InteractionHoldState.generated.h"
+
+class UInteractionManagerComponent;
+
+/**
+ * Replicated state of a hold interaction. Only the instigator and the start time are replicated, so the bandwidth of a
+ * hold doesn't depend on its duration. The progress is computed locally from the synced server time.
+ */
+USTRUCT()
+struct FInteractionHoldState
+{
+	GENERATED_BODY()
+
+	// Manager of the pawn that holds the interaction. Null if nobody holds it.
+	UPROPERTY()
+	TObjectPtr<UInteractionManagerComponent> Instigator = nullptr;
+
+	// Server world time when the hold was started
+	UPROPERTY()
+	double StartServerTime = 0.0;
+};
@@ -3,7 +3,9 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
 #include "Components/ActorComponent.h"
+#include "Common/Structs/InteractionHoldState.h"
 #include "InteractableComponent.generated.h"
 
 class UInteractionManagerComponent;
@@ -17,16 +19,79 @@ class INTERACTIONSYSTEM_API UInteractableComponent : public UActorComponent
 public:
 	UInteractableComponent();
 
+	virtual void PostInitProperties() override;
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
 	const FName& GetHintMeshTag() const { return HintMeshTag; }
 	const FName& GetHintWidgetTag() const { return HintWidgetTag; }
 
+	/**
+	 * Returns the component the interaction popup is attached to when this interactable is selected. It's the component
+	 * with HintWidgetTag or the root component of the owner if there is none.
+	 */
+	USceneComponent* GetHintWidgetAnchor() const;
+
+	// Location of the interaction popup relative to GetHintWidgetAnchor()
+	const FVector& GetHintWidgetOffset() const { return HintWidgetOffset; }
+
+	// Tags that describe what kind of interactable this is (e.g., for bots looking for a specific kind)
+	const FGameplayTagContainer& GetInteractionTags() const { return InteractionTags; }
+	void AddInteractionTag(const FGameplayTag& Tag) { InteractionTags.AddTag(Tag); }
+
 	bool CanInteract() const { return bCanInteract; }
 	void SetCanInteract(const bool bInbCanInteract) { bCanInteract = bInbCanInteract; }
 
 	// Calls the interaction delegate (InteractDelegate)
 	void Interact(UInteractionManagerComponent* InteractionManagerComponent) const;
 
-	// Enables/disables the visibility of the interaction hint
+	// === Hold interaction ===
+
+	// Whether the interaction has to be held for HoldDuration instead of happening instantly
+	bool IsHoldInteraction() const { return HoldDuration > 0; }
+
+	float GetHoldDuration() const { return HoldDuration; }
+
+	const FInteractionHoldState& GetHoldState() const { return HoldState; }
+
+	// Returns the manager that currently holds the interaction or nullptr if nobody holds it
+	UInteractionManagerComponent* GetHoldInstigator() const;
+
+	// Returns the progress of the current hold from 0 to 1 computed from the synced server time
+	float GetHoldProgress() const;
+
+	/**
+	 * Starts the hold for the instigator on the server. Fails if somebody else holds the interaction unless that hold
+	 * was abandoned (see AbandonedHoldTimeout).
+	 * @return True if the hold was started
+	 */
+	bool StartHold(UInteractionManagerComponent* InteractionManagerComponent);
+
+	// Stops the hold on the server if it's held by the instigator
+	void StopHold(const UInteractionManagerComponent* InteractionManagerComponent);
+
+	/**
+	 * Validates the completion of the hold on the server by its start time and interacts if it's valid. The hold is
+	 * stopped either way.
+	 * @param InteractionManagerComponent Manager that claims to have completed the hold
+	 * @param Tolerance How much earlier than HoldDuration the completion is accepted (e.g., because of the latency)
+	 * @return True if the hold was completed
+	 */
+	bool CompleteHold(UInteractionManagerComponent* InteractionManagerComponent, const float Tolerance);
+
+	/**
+	 * Delegate called on the server and on clients when the hold is started or stopped
+	 * @param InteractableComponent Interactable whose hold state was changed
+	 */
+	DECLARE_MULTICAST_DELEGATE_OneParam(FOnHoldStateChangedDelegate, UInteractableComponent* InteractableComponent);
+
+	FOnHoldStateChangedDelegate OnHoldStateChanged;
+
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+	// Enables/disables the visibility of the interaction hint on the meshes. The popup is shown by the manager.
 	virtual void SetInteractionHintVisibility(const bool bNewVisibility);
 
 	/**
@@ -40,30 +105,87 @@ public:
 
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 private:
 	void InitializeHintMeshes();
 	void InitializeHintWidget();
 
+	// Keeps the cell of this interactable in UInteractableGridSubsystem up to date when the owner moves
+	void OnOwnerTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags,
+		ETeleportType Teleport);
+
+	FDelegateHandle OwnerTransformUpdatedDelegateHandle;
+
+	// Returns the world time of the server synced to clients
+	double GetServerTime() const;
+
+	// Returns the elapsed time of the current hold by the synced server time
+	double GetHoldElapsedTime() const;
+
+	void SetHoldState(UInteractionManagerComponent* Instigator, const double StartServerTime);
+
 	// Whether interaction is possible
 	UPROPERTY(EditAnywhere)
 	bool bCanInteract;
+
+	// Tags that describe what kind of interactable this is
+	UPROPERTY(EditAnywhere)
+	FGameplayTagContainer InteractionTags;
+
+	/**
+	 * How long the interaction has to be held (e.g., digging or picking a lock). The interaction happens instantly if
+	 * zero. Only the interactables with a hold are replicated.
+	 */
+	UPROPERTY(EditAnywhere, Category="Hold", meta=(ClampMin=0, UIMin=0, ForceUnits="s"))
+	float HoldDuration = 0.0f;
+
+	/**
+	 * How long after HoldDuration a hold that was neither completed nor stopped can be taken over by somebody else
+	 * (e.g., if the instigator lost the connection)
+	 */
+	UPROPERTY(EditAnywhere, Category="Hold", meta=(ClampMin=0, UIMin=0, ForceUnits="s"))
+	float AbandonedHoldTimeout = 5.0f;
+
+	UPROPERTY(Transient, ReplicatedUsing="OnRep_HoldState")
+	FInteractionHoldState HoldState;
+
+	UFUNCTION()
+	void OnRep_HoldState();
 	
 	// Tag to find meshes to hint when the interaction hint visibility is true
 	UPROPERTY(EditAnywhere, Category="Hint")
 	FName HintMeshTag = TEXT("HintMesh");
 
-	// Tag to find widget that is visible when the interaction hint visibility is true
+	/**
+	 * Tag to find the component the interaction popup is attached to when the interaction hint visibility is true. The
+	 * popup is shared and owned by the UInteractionManagerComponent of the local player, so the component should be a
+	 * plain scene component. A widget component with the tag (an own popup of the interactable) is destroyed when the
+	 * interactable begins play, and the shared popup is shown at its location instead.
+	 */
 	UPROPERTY(EditAnywhere, Category="Hint")
 	FName HintWidgetTag = TEXT("HintWidget");
 	
-	// Material applied to the meshes when the interaction hint visibility is true
-	UPROPERTY(EditAnywhere, Category="Hint")
+	/**
+	 * Material applied to the meshes when the interaction hint visibility is true. It's set only while the hint is
+	 * shown, so the meshes of the other interactables don't draw any overlay.
+	 */
+	UPROPERTY(EditAnywhere, Category="Hint", meta=(EditCondition="!bHintUsesCustomDepth"))
 	TObjectPtr<UMaterialInterface> OverlayMaterialHint;
 
-	// Widget that is visible when the interaction hint visibility is true
-	TWeakObjectPtr<class UInteractPopupWidget> HintWidget;
+	/**
+	 * Whether the hint is drawn by an outline post-process material of the level that reads the custom depth instead
+	 * of OverlayMaterialHint. Only the hinted meshes are rendered into the custom depth, and a single post-process pass
+	 * outlines all of them. Only enable it on maps whose post-process volume has such a material.
+	 */
+	UPROPERTY(EditAnywhere, Category="Hint")
+	bool bHintUsesCustomDepth = false;
+
+	// Component the interaction popup is attached to
+	TWeakObjectPtr<USceneComponent> HintWidgetAnchor;
+
+	FVector HintWidgetOffset = FVector::ZeroVector;
 	
-	// Meshes to hint when the interaction hint visibility is true
+	// Meshes to hint when the interaction hint visibility is true. Gathered once when the interactable begins play.
 	TArray<TWeakObjectPtr<UMeshComponent>> HintMeshes;
 };
@@ -3,14 +3,21 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "WorldCollision.h"
+#include "Components/WidgetComponent.h"
+#include "UObject/ObjectKey.h"
 #include "InteractionManagerComponent.generated.h"
 
 class UInteractableComponent;
+class UInteractableGridSubsystem;
+class UInteractPopupWidget;
 
 /**
  * Handles pawn interaction logic by detecting, selecting, and processing interactions with nearby interactable objects.
- * Uses overlap detection to maintain a pool of nearby interactables and automatically selects the best candidate.
- * Must attach at least one UPrimitiveComponent for selection.
+ * Queries UInteractableGridSubsystem to maintain a pool of nearby interactables and automatically selects the best
+ * candidate. The manager of the local player owns a small pool of interaction popups and attaches one of them to the
+ * selected interactable, so interactables don't need their own popup widgets.
  */
 UCLASS()
 class INTERACTIONSYSTEM_API UInteractionManagerComponent : public USceneComponent
@@ -25,6 +32,8 @@ public:
 		return SelectedInteractableComponent.Get();
 	}
 
+	float GetMaxInteractionDistance() const { return MaxInteractionDistance; }
+
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType,
 		FActorComponentTickFunction* ThisTickFunction) override;
 
@@ -40,9 +49,56 @@ public:
 	 * @return True if interaction was successful
 	 */
 	bool TryInteract(UInteractableComponent* InteractableComponent);
+
+	/**
+	 * Starts holding the interaction with the interactable that has a hold (see UInteractableComponent::HoldDuration).
+	 * The hold is completed by a local timer and validated by the server from its start time, so nothing is sent while
+	 * it's held. Stops the previous hold if there is one.
+	 * @param InteractableComponent Target component to hold the interaction with
+	 * @return True if the hold was started or requested from the server
+	 */
+	bool StartHoldInteraction(UInteractableComponent* InteractableComponent);
+
+	// Stops the current hold before it's completed (e.g., when the input is released)
+	void StopHoldInteraction();
+
+	bool IsHoldingInteraction() const { return HeldInteractableComponent.IsValid(); }
+
+	UInteractableComponent* GetHeldInteractableComponent() const { return HeldInteractableComponent.Get(); }
+
+	/**
+	 * Interacts directly on the server without the RPC and the line-of-sight trace of the server validation. Only the
+	 * distance is checked. Used by TryInteract when the owner has the authority (e.g., bots and the listen server
+	 * host).
+	 * @param InteractableComponent Target component to interact with
+	 * @return True if interaction was successful
+	 */
+	bool InteractAsAuthority(UInteractableComponent* InteractableComponent);
+
+	/**
+	 * Gathers the visible interactables that can be interacted with around the owner without any traces.
+	 * @param Tag Tag the interactables must have (parent tags match too). Any interactable matches if the tag is empty.
+	 * @param MaxDistance Maximum distance from the owner.
+	 * @param OutInteractables Found interactables sorted by the distance to the owner, the nearest first.
+	 */
+	void FindInteractables(const FGameplayTag& Tag, const float MaxDistance,
+		TArray<UInteractableComponent*>& OutInteractables) const;
+
+	// Returns the nearest interactable with the tag within the distance or nullptr if there is none
+	UInteractableComponent* FindNearestInteractable(const FGameplayTag& Tag, const float MaxDistance) const;
+
+	/**
+	 * Server-side check of an interaction request. Drops the request if the owner exceeds the rate limit, accepts it
+	 * without a trace if the same interactable was validated recently and nobody moved, and otherwise checks the
+	 * distance and the line of sight and caches the positive result.
+	 * @param InteractableComponent Component to interact with
+	 * @return True if the interaction is allowed
+	 */
+	bool ValidateServerInteraction(const UInteractableComponent* InteractableComponent);
 	
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 private:
 	/**
@@ -52,40 +108,264 @@ private:
 	 */
 	bool IsPathObstructed(const UInteractableComponent* InteractableComponent) const;
 
+	// Returns the parameters of the line-of-sight traces between the owner and the given interactable actor
+	FCollisionQueryParams GetLineOfSightTraceParams(const AActor* InteractableActor) const;
+
+	/**
+	 * Returns the cached line-of-sight result for the interactable and requests an asynchronous trace if there is no
+	 * result yet or the owner or the interactable moved further than LineOfSightCacheDistanceThreshold since the last
+	 * request. The last result is used while a new trace is pending.
+	 * @param InteractableComponent Target interactable to check
+	 * @param ViewerLocation Current location of the owner
+	 * @return True if the last finished trace wasn't obstructed. False if there is no finished trace yet.
+	 */
+	bool HasCachedLineOfSight(const UInteractableComponent* InteractableComponent, const FVector& ViewerLocation);
+
+	void OnLineOfSightTraceDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum,
+		TObjectKey<UInteractableComponent> InteractableComponentKey);
+
+	/**
+	 * Updates the pool and the selection if the view changed further than the thresholds, the pool or the line of sight
+	 * to the candidates changed, or the fallback selection is due. Turns the tick off if there is nothing to select.
+	 */
+	void UpdateSelection();
+
+	/**
+	 * Refills the pool with the interactables within MaxInteractionDistance that can be interacted with and removes the
+	 * selection if the selected interactable is no longer in the pool
+	 * @return True if the pool was changed
+	 */
+	bool UpdateInteractableComponentsPool();
+
 	/**
 	 * Selects the most suitable interactable component from the current pool
-	 * Considers view direction and obstacles
+	 * Culls the candidates outside the view cone, ranks the rest by the angle to the view direction and the distance,
+	 * and checks the line of sight only for the top MaxLineOfSightChecks of them
 	 */
-	void SelectInteractableComponent();
-	
-	UFUNCTION()
-	void OnAddToInteractableComponentsPool(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
-		UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
+	void SelectInteractableComponent(const FVector& ViewLocation, const FVector& ViewDirection);
+
+	/**
+	 * Turns the tick off and checks for new candidates by a timer every IdleCheckInterval if true. Turns the tick back
+	 * on otherwise.
+	 */
+	void SetSelectionIdle(const bool bIdle);
+
+	void OnIdleCheck();
+
+	// Hides the hint of the previously selected interactable and shows the hint of the new one
+	void SetSelectedInteractableComponent(UInteractableComponent* NewSelectedInteractableComponent);
+
+	// Creates the pool of popup widget components. Only for the locally controlled pawns.
+	void InitializePopupWidgets();
 
-	UFUNCTION()
-	void OnDeleteFromInteractableComponentsPool(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
-		UPrimitiveComponent* OtherComp, int32 OtherBodyIndex);
+	// Attaches the next popup from the pool to the interactable and shows it
+	void ShowPopupWidget(const UInteractableComponent* InteractableComponent);
+
+	// Hides the currently shown popup. It stays attached to its interactable while the hide animation is played.
+	void HidePopupWidget();
 
 	/**
-	 * Server-side interaction validation and execution
+	 * Server-side interaction validation and execution. Invalid requests are dropped instead of failing the RPC
+	 * validation, so a client isn't disconnected because of the latency or the rate limit.
 	 * @param InteractableComponent Component to interact with
 	 */
-	UFUNCTION(Server, Reliable, WithValidation)
+	UFUNCTION(Server, Reliable)
 	void Server_TryInteract(UInteractableComponent* InteractableComponent);
 
+	// Takes a token from the bucket of interaction requests if there is one
+	bool ConsumeInteractionRequestToken();
+
+	bool IsWithinInteractionDistance(const UInteractableComponent* InteractableComponent) const;
+
+	// Whether to interact directly instead of calling the server RPCs (see InteractAsAuthority)
+	bool ShouldInteractAsAuthority() const;
+
+	// Stops the hold if the player stopped looking at the held interactable
+	void StopHoldIfNotSelected();
+
+	// Completes the hold locally on the authority or asks the server to complete it
+	void OnHoldTimerFinished();
+
+	// Validates the start of a hold like an instant interaction and starts it
+	UFUNCTION(Server, Reliable)
+	void Server_StartHoldInteraction(UInteractableComponent* InteractableComponent);
+
+	UFUNCTION(Server, Reliable)
+	void Server_StopHoldInteraction(UInteractableComponent* InteractableComponent);
+
+	// Completes the hold if it has been held long enough since its start on the server and the owner is still nearby
+	UFUNCTION(Server, Reliable)
+	void Server_CompleteHoldInteraction(UInteractableComponent* InteractableComponent);
+
 	// Maximum distance at which interaction is possible
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Interaction", meta=(AllowPrivateAccess = "true", ClampMin=0,
 		UIMin=0, ForceUnits="cm"))
 	float MaxInteractionDistance = 500.0f;
 
+	/**
+	 * Distance the owner or an interactable has to move to trace the line of sight between them again. The trace of the
+	 * selection is requested asynchronously and its result is available only in the next frame.
+	 */
+	UPROPERTY(EditAnywhere, Category="Interaction|Selection", meta=(ClampMin=0, UIMin=0, ForceUnits="cm"))
+	float LineOfSightCacheDistanceThreshold = 10.0f;
+
+	// How many interaction requests per second the server accepts from the owner on average
+	UPROPERTY(EditAnywhere, Category="Interaction|Server", meta=(ClampMin=0.1, UIMin=0.1, ForceUnits="Hz"))
+	float InteractionRequestsRate = 10.0f;
+
+	// How many interaction requests the server accepts from the owner at once before the rate limit applies
+	UPROPERTY(EditAnywhere, Category="Interaction|Server", meta=(ClampMin=1, UIMin=1))
+	float InteractionRequestsBurst = 5.0f;
+
+	// How long a validated interaction is accepted again without a trace if neither side moved
+	UPROPERTY(EditAnywhere, Category="Interaction|Server", meta=(ClampMin=0, UIMin=0, ForceUnits="s"))
+	float ValidationCacheDuration = 0.5f;
+
+	// Distance the owner or the interactable has to move to validate the interaction with a trace again
+	UPROPERTY(EditAnywhere, Category="Interaction|Server", meta=(ClampMin=0, UIMin=0, ForceUnits="cm"))
+	float ValidationCacheDistanceThreshold = 10.0f;
+
+	/**
+	 * How much earlier than the hold duration since its start on the server the completion of a hold is accepted.
+	 * Covers the jitter of the latency between the start and the completion requests.
+	 */
+	UPROPERTY(EditAnywhere, Category="Interaction|Server", meta=(ClampMin=0, UIMin=0, ForceUnits="s"))
+	float HoldCompletionTolerance = 0.2f;
+
+	// Candidates further than this angle from the view direction can't be selected
+	UPROPERTY(EditAnywhere, Category="Interaction|Selection", meta=(ClampMin=0, ClampMax=180, UIMin=0, UIMax=180,
+		ForceUnits="deg"))
+	float SelectionConeHalfAngle = 60.0f;
+
+	/**
+	 * How much the distance to a candidate lowers its score relative to the angle. The score is the dot product of the
+	 * view direction and the direction to the candidate minus this weight multiplied by the distance divided by
+	 * MaxInteractionDistance.
+	 */
+	UPROPERTY(EditAnywhere, Category="Interaction|Selection", meta=(ClampMin=0, UIMin=0))
+	float SelectionDistanceWeight = 0.1f;
+
+	/**
+	 * Maximum number of the best-scored candidates whose line of sight is checked per selection. Caps the number of
+	 * traces no matter how many interactables are nearby.
+	 */
+	UPROPERTY(EditAnywhere, Category="Interaction|Selection", meta=(ClampMin=1, UIMin=1))
+	int32 MaxLineOfSightChecks = 4;
+
+	// Distance the view has to move to update the selection
+	UPROPERTY(EditAnywhere, Category="Interaction|Selection", meta=(ClampMin=0, UIMin=0, ForceUnits="cm"))
+	float SelectionLocationThreshold = 5.0f;
+
+	// Angle the view has to turn to update the selection
+	UPROPERTY(EditAnywhere, Category="Interaction|Selection", meta=(ClampMin=0, UIMin=0, ForceUnits="deg"))
+	float SelectionAngleThreshold = 1.0f;
+
+	// How many times per second the selection is updated when nothing changes (e.g., to notice moving candidates)
+	UPROPERTY(EditAnywhere, Category="Interaction|Selection", meta=(ClampMin=0.1, UIMin=0.1, ForceUnits="Hz"))
+	float FallbackSelectionRate = 5.0f;
+
+	// How often new candidates are looked for while the tick is off because there is nothing to select
+	UPROPERTY(EditAnywhere, Category="Interaction|Selection", meta=(ClampMin=0.01, UIMin=0.01, ForceUnits="s"))
+	float IdleCheckInterval = 0.1f;
+
+	/**
+	 * Widget of the interaction popup shown on the selected interactable. Defaults to the popup of the plugin. It's
+	 * loaded only by the managers of the local players, so servers never load it.
+	 */
+	UPROPERTY(EditAnywhere, Category="Interaction|Popup")
+	TSoftClassPtr<UInteractPopupWidget> PopupWidgetClass;
+
+	UPROPERTY(EditAnywhere, Category="Interaction|Popup")
+	EWidgetSpace PopupWidgetSpace = EWidgetSpace::Screen;
+
+	/**
+	 * Number of popups in the pool. The popup of the previous selection plays its hide animation while the next one is
+	 * shown, so there should be at least two of them.
+	 */
+	UPROPERTY(EditAnywhere, Category="Interaction|Popup", meta=(ClampMin=1, UIMin=1))
+	int32 PopupWidgetsPoolSize = 2;
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UWidgetComponent>> PopupWidgetComponents;
+
+	int32 NextPopupWidgetIndex = 0;
+
+	TWeakObjectPtr<UInteractPopupWidget> ShownPopupWidget;
+
 	// Controller that owns this interaction component 
 	TWeakObjectPtr<AController> OwnerController;
 
+	TWeakObjectPtr<UInteractableGridSubsystem> GridSubsystem;
+
 	// Pool of all interactable components currently in detection range 
 	TArray<TWeakObjectPtr<UInteractableComponent>> InteractableComponentsPool;
 
+	// Pool before the last update. Kept between the updates to not reallocate it every time.
+	TArray<TWeakObjectPtr<UInteractableComponent>> PreviousInteractableComponentsPool;
+
+	// Result of the last grid query. Kept between the updates to not reallocate it every tick.
+	TArray<UInteractableComponent*> FoundInteractableComponents;
+
+	struct FLineOfSightCacheEntry
+	{
+		// Locations of the owner and the interactable the last trace was requested for
+		FVector ViewerLocation = FVector::ZeroVector;
+		FVector InteractableLocation = FVector::ZeroVector;
+
+		// Handle of the last requested trace. Results of the older traces are ignored.
+		FTraceHandle TraceHandle;
+
+		bool bTracePending = false;
+		bool bHasResult = false;
+		bool bObstructed = false;
+	};
+
+	struct FSelectionCandidate
+	{
+		UInteractableComponent* InteractableComponent;
+		float Score;
+	};
+
+	// Candidates of the last selection sorted by their scores. Kept between the selections to not reallocate them.
+	TArray<FSelectionCandidate> RankedCandidates;
+
+	// Line-of-sight results of the interactables in the pool
+	TMap<TObjectKey<UInteractableComponent>, FLineOfSightCacheEntry> LineOfSightCache;
+
+	// === Server-side validation state ===
+
+	struct FValidatedInteraction
+	{
+		double ExpirationTime;
+
+		// Locations of the owner and the interactable when the interaction was validated
+		FVector InstigatorLocation;
+		FVector InteractableLocation;
+	};
+
+	// Interactions of the owner that passed the validation recently
+	TMap<TObjectKey<UInteractableComponent>, FValidatedInteraction> ValidatedInteractions;
+
+	float InteractionRequestTokens = 0.0f;
+	double LastInteractionRequestTokensUpdateTime = -1.0;
+
 	// Currently selected/focused interactable component (the best candidate from pool) 
 	TWeakObjectPtr<UInteractableComponent> SelectedInteractableComponent;
 
+	// View and time of the last selection update
+	FVector LastSelectionViewLocation = FVector::ZeroVector;
+	FVector LastSelectionViewDirection = FVector::ZeroVector;
+	double LastSelectionTime = 0.0;
+
+	// Whether the selection has to be updated regardless of the view changes
+	bool bSelectionDirty = true;
+
+	FTimerHandle IdleCheckTimerHandle;
+
+	// Interactable whose interaction is held by the owner. Tracked both by the owning client and the server.
+	TWeakObjectPtr<UInteractableComponent> HeldInteractableComponent;
+
+	FTimerHandle HoldTimerHandle;
+
 	bool bIsLocallyControlled = false;
 };
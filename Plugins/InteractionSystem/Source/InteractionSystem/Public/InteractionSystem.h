@@ -3,6 +3,18 @@
 #pragma once
 
 #include "Modules/ModuleManager.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogInteractionSystem, Log, All);
+
+DECLARE_STATS_GROUP(TEXT("Interaction"), STATGROUP_Interaction, STATCAT_Advanced);
+
+// Category of the interaction counters and timings in the CSV profiles (e.g., -csvCaptureFrames=N on headless runs)
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(INTERACTIONSYSTEM_API, Interaction);
+
+// Insights channel of the interaction scopes. Enable it with -trace=cpu,Interaction.
+UE_TRACE_CHANNEL_EXTERN(InteractionChannel, INTERACTIONSYSTEM_API);
 
 class FInteractionSystemModule : public IModuleInterface
 {
@@ -0,0 +1,75 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "InteractableGridSubsystem.generated.h"
+
+class UInteractableComponent;
+
+/**
+ * Uniform spatial hash grid of all interactable components in the world. Every UInteractableComponent registers itself
+ * in the cell of its owner location and moves to another cell when its owner moves, so finding interactables around a
+ * point only visits the cells that intersect the query sphere instead of relying on physics overlaps.
+ */
+UCLASS(Config=Game)
+class INTERACTIONSYSTEM_API UInteractableGridSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	// Adds the interactable to the cell of its owner location
+	void RegisterInteractable(UInteractableComponent* InteractableComponent);
+
+	// Removes the interactable from the grid
+	void UnregisterInteractable(const UInteractableComponent* InteractableComponent);
+
+	// Updates the location of the registered interactable and moves it to another cell if it left the current one
+	void UpdateInteractableLocation(UInteractableComponent* InteractableComponent);
+
+	/**
+	 * Gathers all registered interactables whose owners are located within the radius of the point.
+	 * @param Point Center of the query sphere.
+	 * @param Radius Radius of the query sphere.
+	 * @param OutInteractables Interactables within the sphere in no particular order.
+	 */
+	void FindInteractablesInRadius(const FVector& Point, const float Radius,
+		TArray<UInteractableComponent*>& OutInteractables) const;
+
+	int32 GetInteractablesNumber() const { return CellsByInteractable.Num(); }
+
+	float GetCellSize() const { return CellSize; }
+
+private:
+	/**
+	 * Size of a grid cell. Should be close to the radius of the most frequent queries (e.g.,
+	 * UInteractionManagerComponent::MaxInteractionDistance), so a query visits only a few cells.
+	 */
+	UPROPERTY(Config)
+	float CellSize = 500.0f;
+
+	struct FGridEntry
+	{
+		TWeakObjectPtr<UInteractableComponent> InteractableComponent;
+
+		// Location of the owner of the interactable, cached to not touch the actor for every distance check
+		FVector Location;
+	};
+
+	TMap<FIntVector, TArray<FGridEntry>> Cells;
+
+	// Cell of every registered interactable
+	TMap<TObjectKey<UInteractableComponent>, FIntVector> CellsByInteractable;
+
+	FIntVector GetCellCoordinates(const FVector& Location) const;
+
+	// Adds the entry to the cell and remembers the cell of the interactable
+	void AddEntry(UInteractableComponent* InteractableComponent, const FVector& Location, const FIntVector& Cell);
+
+	// Removes the entry of the interactable from the cell. Empty cells are removed too.
+	void RemoveEntry(const UInteractableComponent* InteractableComponent, const FIntVector& Cell);
+};
@@ -6,7 +6,7 @@
 #include "Blueprint/UserWidget.h"
 #include "InteractPopupWidget.generated.h"
 
-// Can be used in InteractableComponent with a component to show a hint
+// Popup shown on the selected interactable by UInteractionManagerComponent (either from its pool or the own one)
 UCLASS()
 class INTERACTIONSYSTEM_API UInteractPopupWidget : public UUserWidget
 {
@@ -3,8 +3,18 @@
 #include "ActorComponents/InventoryManagerComponent.h"
 
 #include "InventorySystem.h"
+#include "GameFramework/PlayerController.h"
 #include "Net/UnrealNetwork.h"
+#include "Net/Core/Misc/NetConditionGroupManager.h"
 #include "Objects/InventoryManagerFragment.h"
+#include "Subsystems/InventoryItemIndexSubsystem.h"
+
+static TAutoConsoleVariable<bool> CVarFlatSlotsReplication(
+	TEXT("Inventory.FlatSlotsReplication"),
+	false,
+	TEXT("Whether inventory slots are replicated as a single flat fast array instead of nested fast arrays by types. ")
+	TEXT("Only affects the inventories created after the change."),
+	ECVF_Default);
 
 UInventoryManagerComponent::UInventoryManagerComponent()
 {
@@ -12,16 +22,52 @@ UInventoryManagerComponent::UInventoryManagerComponent()
 
 	bReplicateUsingRegisteredSubObjectList = true;
 	SetIsReplicatedByDefault(true);
+
+	SubscribersNetGroup = FName(TEXT("InventorySubscribers"), GetUniqueID());
+}
+
+void UInventoryManagerComponent::PostInitProperties()
+{
+	Super::PostInitProperties();
+
+	InventoryContent.SetOwner(this);
+	FlatInventoryContent.SetOwner(this);
+
+	bFlatSlotsReplication = CVarFlatSlotsReplication.GetValueOnGameThread();
+}
+
+void UInventoryManagerComponent::SetItemsReplicationPolicy(
+	const EInventoryItemsReplicationPolicy NewItemsReplicationPolicy)
+{
+#if DO_ENSURE
+	ensureAlwaysMsgf(!IsReadyForReplication(),
+		TEXT("The replication policy can't be changed after the component is ready for replication!"));
+#endif
+
+	ItemsReplicationPolicy = NewItemsReplicationPolicy;
 }
 
 void UInventoryManagerComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 	
-	DOREPLIFETIME(ThisClass, InventoryContent);
+	// Only one of the layouts is replicated (see GetReplicatedCustomConditionState)
+	DOREPLIFETIME_CONDITION(ThisClass, InventoryContent, COND_Custom);
+	DOREPLIFETIME_CONDITION(ThisClass, FlatInventoryContent, COND_Custom);
+
 	DOREPLIFETIME(ThisClass, Fragments);
 }
 
+void UInventoryManagerComponent::GetReplicatedCustomConditionState(
+	FCustomPropertyConditionState& OutActiveState) const
+{
+	Super::GetReplicatedCustomConditionState(OutActiveState);
+
+	// The layout is chosen per component, so both layouts can be compared in the same session
+	DOREPCUSTOMCONDITION_ACTIVE_FAST(ThisClass, InventoryContent, !bFlatSlotsReplication);
+	DOREPCUSTOMCONDITION_ACTIVE_FAST(ThisClass, FlatInventoryContent, bFlatSlotsReplication);
+}
+
 void UInventoryManagerComponent::BeginPlay()
 {
 	Super::BeginPlay();
@@ -31,10 +77,12 @@ void UInventoryManagerComponent::BeginPlay()
 		return;
 	}
 
+	ItemIndexSubsystem = GetWorld()->GetSubsystem<UInventoryItemIndexSubsystem>();
+
 #if WITH_EDITORONLY_DATA && !NO_LOGGING
 	if (bLogInventoryContent)
 	{
-		OnContentChanged.AddLambda([this]
+		OnContentChanged.AddLambda([this](const FInventoryContentChange& Change)
 		{
 			LogInventoryContent();
 		});
@@ -69,6 +117,17 @@ void UInventoryManagerComponent::BeginPlay()
 	// === Construct inventory ===
 
 	InventoryContent.Construct(SlotsNumberByTypes);
+
+	if (IsFlatSlotsReplicationEnabled())
+	{
+		FlatInventoryContent.Construct(InventoryContent);
+	}
+
+	if (PendingSaveData.IsSet())
+	{
+		LoadContent(PendingSaveData.GetValue());
+		PendingSaveData.Reset();
+	}
 }
 
 void UInventoryManagerComponent::ReadyForReplication()
@@ -82,7 +141,7 @@ void UInventoryManagerComponent::ReadyForReplication()
 	
 	ForEachInventoryItemInstance([this](UInventoryItemInstance* ItemInstance)
 	{
-		AddReplicatedSubObject(ItemInstance);
+		AddItemInstanceReplicatedSubObject(ItemInstance);
 	});
 
 	for (UInventoryManagerFragment* Fragment : Fragments)
@@ -91,6 +150,126 @@ void UInventoryManagerComponent::ReadyForReplication()
 	}
 }
 
+void UInventoryManagerComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	// The items of this inventory don't exist in the world anymore
+	if (ItemIndexSubsystem.IsValid())
+	{
+		ForEachInventoryItemInstance([this](const UInventoryItemInstance* ItemInstance)
+		{
+			ItemIndexSubsystem->RemoveItems(this, ItemInstance->GetDefinition(), ItemInstance->GetStackCount());
+		});
+	}
+
+	// Don't leave the subscribers in the net condition group of the inventory that no longer exists
+	for (const TWeakObjectPtr<APlayerController>& Subscriber : Subscribers)
+	{
+		if (Subscriber.IsValid())
+		{
+			Subscriber->ExcludeFromNetConditionGroup(SubscribersNetGroup);
+		}
+	}
+
+	Subscribers.Empty();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UInventoryManagerComponent::AddItemInstanceReplicatedSubObject(UInventoryItemInstance* ItemInstance)
+{
+	switch (ItemsReplicationPolicy)
+	{
+	case EInventoryItemsReplicationPolicy::Everyone:
+		AddReplicatedSubObject(ItemInstance);
+
+		break;
+
+	case EInventoryItemsReplicationPolicy::OwnerOnly:
+		AddReplicatedSubObject(ItemInstance, COND_OwnerOnly);
+
+		break;
+
+	case EInventoryItemsReplicationPolicy::Subscribers:
+		AddReplicatedSubObject(ItemInstance, COND_NetGroup);
+		FNetConditionGroupManager::RegisterSubObjectInGroup(ItemInstance, SubscribersNetGroup);
+
+		break;
+	}
+}
+
+void UInventoryManagerComponent::RemoveItemInstanceReplicatedSubObject(UInventoryItemInstance* ItemInstance)
+{
+	if (ItemsReplicationPolicy == EInventoryItemsReplicationPolicy::Subscribers)
+	{
+		FNetConditionGroupManager::UnregisterSubObjectFromGroup(ItemInstance, SubscribersNetGroup);
+	}
+
+	RemoveReplicatedSubObject(ItemInstance);
+}
+
+void UInventoryManagerComponent::AddSubscriber(APlayerController* PlayerController)
+{
+#if DO_CHECK
+	check(IsValid(PlayerController));
+#endif
+
+#if DO_ENSURE
+	ensureAlways(GetOwner()->HasAuthority());
+#endif
+
+	if (!ensureAlwaysMsgf(ItemsReplicationPolicy == EInventoryItemsReplicationPolicy::Subscribers,
+		TEXT("Subscribers are only supported by the Subscribers replication policy!")))
+	{
+		return;
+	}
+
+	RemoveInvalidSubscribers();
+
+	if (IsSubscriber(PlayerController))
+	{
+		return;
+	}
+
+	// The item instances registered in this group will start replicating to the player during the next net update
+	PlayerController->IncludeInNetConditionGroup(SubscribersNetGroup);
+
+	Subscribers.Add(PlayerController);
+}
+
+void UInventoryManagerComponent::RemoveSubscriber(APlayerController* PlayerController)
+{
+#if DO_CHECK
+	check(IsValid(PlayerController));
+#endif
+
+#if DO_ENSURE
+	ensureAlways(GetOwner()->HasAuthority());
+#endif
+
+	RemoveInvalidSubscribers();
+
+	if (Subscribers.Remove(PlayerController) > 0)
+	{
+		PlayerController->ExcludeFromNetConditionGroup(SubscribersNetGroup);
+	}
+}
+
+void UInventoryManagerComponent::RemoveInvalidSubscribers()
+{
+	Subscribers.RemoveAll([](const TWeakObjectPtr<APlayerController>& Subscriber)
+	{
+		return !Subscriber.IsValid();
+	});
+}
+
+bool UInventoryManagerComponent::IsSubscriber(const APlayerController* PlayerController) const
+{
+	return Subscribers.ContainsByPredicate([PlayerController](const TWeakObjectPtr<APlayerController>& Subscriber)
+	{
+		return Subscriber.Get() == PlayerController;
+	});
+}
+
 UInventoryItemInstance* UInventoryManagerComponent::GetItemInstance(const int32 SlotIndex,
 	const FGameplayTag& SlotTypeTag) const
 {
@@ -121,8 +300,285 @@ void UInventoryManagerComponent::ForEachInventoryItemInstance(
 	}
 }
 
-bool UInventoryManagerComponent::AddItem(const UInventoryItemInstance* ItemInstance, int32 SlotIndex,
+void UInventoryManagerComponent::GatherItemsCount(
+	TMap<TSubclassOf<UInventoryItemDefinition>, int32>& OutItemsCount) const
+{
+	OutItemsCount.Reset();
+
+	ForEachInventoryItemInstance([&OutItemsCount](const UInventoryItemInstance* ItemInstance)
+	{
+		OutItemsCount.FindOrAdd(ItemInstance->GetDefinition()) += ItemInstance->GetStackCount();
+	});
+}
+
+void UInventoryManagerComponent::SaveContent(FInventorySaveData& OutSaveData) const
+{
+	OutSaveData.Reset();
+
+	for (const FInventorySlotsTypedArray& TypedArray : InventoryContent.GetItems())
+	{
+		const int32 SlotTypeIndex = OutSaveData.SlotTypeTags.AddUnique(TypedArray.TypeTag);
+		const TArray<FInventorySlot>& Slots = TypedArray.Array.GetItems();
+
+		// The indices are narrowed to the types of the save record, so the content that doesn't fit isn't saved
+		if (!ensureAlwaysMsgf(SlotTypeIndex <= MAX_uint8 && Slots.Num() - 1 <= MAX_uint16,
+			TEXT("Too many slot types or slots of type %s to save!"), *TypedArray.TypeTag.ToString()))
+		{
+			continue;
+		}
+
+		for (int32 SlotIndex = 0; SlotIndex < Slots.Num(); ++SlotIndex)
+		{
+			const UInventoryItemInstance* ItemInstance = Slots[SlotIndex].Instance;
+
+			if (!IsValid(ItemInstance))
+			{
+				continue;
+			}
+
+			const TSubclassOf<UInventoryItemDefinition> Definition = ItemInstance->GetDefinition();
+			const int32 DefinitionIndex = OutSaveData.Definitions.AddUnique(Definition.Get());
+
+			if (!ensureAlwaysMsgf(DefinitionIndex <= MAX_uint16, TEXT("Too many item definitions to save!")))
+			{
+				continue;
+			}
+
+			FInventorySlotSaveData& SlotSaveData = OutSaveData.Slots.AddDefaulted_GetRef();
+			SlotSaveData.DefinitionIndex = DefinitionIndex;
+			SlotSaveData.SlotTypeIndex = SlotTypeIndex;
+			SlotSaveData.SlotIndex = SlotIndex;
+
+			const TArray<FInstanceStatsItem>& DefaultStats =
+				Definition->GetDefaultObject<UInventoryItemDefinition>()->GetDefaultInstanceStats();
+
+			for (const FInstanceStatsItem& Stat : ItemInstance->GetInstanceStats().GetAllStats())
+			{
+				const FInstanceStatsItem* DefaultStat = DefaultStats.FindByPredicate(
+					[&Stat](const FInstanceStatsItem& Item)
+					{
+						return Item.Tag == Stat.Tag;
+					});
+
+				if (DefaultStat && DefaultStat->Value == Stat.Value)
+				{
+					continue;
+				}
+
+				const int32 TagIndex = OutSaveData.StatTags.AddUnique(Stat.Tag);
+
+				if (!ensureAlwaysMsgf(TagIndex <= MAX_uint8, TEXT("Too many stat tags to save!")))
+				{
+					continue;
+				}
+
+				FInventoryItemStatSaveData& StatSaveData = SlotSaveData.ChangedStats.AddDefaulted_GetRef();
+				StatSaveData.TagIndex = TagIndex;
+				StatSaveData.Value = Stat.Value;
+			}
+		}
+	}
+}
+
+void UInventoryManagerComponent::LoadContent(const FInventorySaveData& SaveData)
+{
+#if DO_ENSURE
+	ensureAlways(GetOwner()->HasAuthority());
+#endif
+
+	// The slots are constructed on BeginPlay
+	if (InventoryContent.GetItems().IsEmpty())
+	{
+		PendingSaveData = SaveData;
+
+		return;
+	}
+
+	TArray<UInventoryItemInstance*> ItemInstances;
+	CreateItemInstances(SaveData, this, ItemInstances);
+
+	// === Clear the current content ===
+
+	for (int32 SlotsArrayIndex = 0; SlotsArrayIndex < InventoryContent.GetItems().Num(); ++SlotsArrayIndex)
+	{
+		const FInventorySlotsArray& SlotsArray = InventoryContent[SlotsArrayIndex].Array;
+
+		for (int32 SlotIndex = 0; SlotIndex < SlotsArray.GetItems().Num(); ++SlotIndex)
+		{
+			if (!SlotsArray.IsSlotEmpty(SlotIndex))
+			{
+				SetSlotInstance(nullptr, SlotsArrayIndex, SlotIndex);
+			}
+		}
+	}
+
+	// === Put the loaded items into their slots ===
+
+	for (int32 i = 0; i < SaveData.Slots.Num(); ++i)
+	{
+		const FInventorySlotSaveData& SlotSaveData = SaveData.Slots[i];
+
+		if (!ItemInstances[i] || !ensureAlways(SaveData.SlotTypeTags.IsValidIndex(SlotSaveData.SlotTypeIndex)))
+		{
+			continue;
+		}
+
+		const int32 SlotsArrayIndex = GetSlotsArrayIndex(SaveData.SlotTypeTags[SlotSaveData.SlotTypeIndex]);
+
+		// The number of slots could be reduced since the game was saved
+		if (SlotsArrayIndex == INDEX_NONE ||
+			!ensureAlways(InventoryContent[SlotsArrayIndex].Array.IsValidSlotIndex(SlotSaveData.SlotIndex)))
+		{
+			continue;
+		}
+
+		SetSlotInstance(ItemInstances[i], SlotsArrayIndex, SlotSaveData.SlotIndex);
+	}
+}
+
+void UInventoryManagerComponent::CreateItemInstances(const FInventorySaveData& SaveData, UObject* Outer,
+	TArray<UInventoryItemInstance*>& OutItemInstances)
+{
+	OutItemInstances.Reset(SaveData.Slots.Num());
+
+	TArray<TSubclassOf<UInventoryItemDefinition>, TInlineAllocator<16>> Definitions;
+	Definitions.Reserve(SaveData.Definitions.Num());
+
+	for (const TSoftClassPtr<UInventoryItemDefinition>& Definition : SaveData.Definitions)
+	{
+		Definitions.Add(Definition.LoadSynchronous());
+	}
+
+	for (const FInventorySlotSaveData& SlotSaveData : SaveData.Slots)
+	{
+		const bool bValidDefinition = Definitions.IsValidIndex(SlotSaveData.DefinitionIndex) &&
+			IsValid(Definitions[SlotSaveData.DefinitionIndex]);
+
+		if (!ensureAlways(bValidDefinition))
+		{
+			OutItemInstances.Add(nullptr);
+
+			continue;
+		}
+
+		UInventoryItemInstance* ItemInstance = NewObject<UInventoryItemInstance>(Outer);
+		ItemInstance->Initialize(Definitions[SlotSaveData.DefinitionIndex]);
+
+		for (const FInventoryItemStatSaveData& StatSaveData : SlotSaveData.ChangedStats)
+		{
+			if (ensureAlways(SaveData.StatTags.IsValidIndex(StatSaveData.TagIndex)))
+			{
+				ItemInstance->SetInstanceStat(FInstanceStatsItem(SaveData.StatTags[StatSaveData.TagIndex],
+					StatSaveData.Value));
+			}
+		}
+
+		OutItemInstances.Add(ItemInstance);
+	}
+}
+
+int32 UInventoryManagerComponent::GetSlotsArrayIndex(const FGameplayTag& SlotTypeTag) const
+{
+	const int32 SlotsArrayIndex = InventoryContent.IndexOfByTag(SlotTypeTag);
+
+#if DO_ENSURE
+	ensureAlwaysMsgf(SlotsArrayIndex != INDEX_NONE, TEXT("Failed to find a slots array by tag %s"),
+		*SlotTypeTag.ToString());
+#endif
+
+	return SlotsArrayIndex;
+}
+
+void UInventoryManagerComponent::SetSlotInstance(UInventoryItemInstance* NewInstance, const int32 SlotsArrayIndex,
+	const int32 SlotIndex)
+{
+	UInventoryItemInstance* OldInstance = InventoryContent.GetInstance(SlotsArrayIndex, SlotIndex);
+
+	// Stop replication of the old item instance if bReplicateUsingRegisteredSubObjectList is enabled
+	if (IsValid(OldInstance) && IsUsingRegisteredSubObjectList())
+	{
+		RemoveItemInstanceReplicatedSubObject(OldInstance);
+	}
+
+	if (IsValid(OldInstance) && ItemIndexSubsystem.IsValid())
+	{
+		ItemIndexSubsystem->RemoveItems(this, OldInstance->GetDefinition(), OldInstance->GetStackCount());
+	}
+
+	InventoryContent.SetInstance(NewInstance, SlotsArrayIndex, SlotIndex);
+
+	if (IsFlatSlotsReplicationEnabled())
+	{
+		FlatInventoryContent.SetInstance(NewInstance, SlotsArrayIndex, SlotIndex);
+	}
+
+	/**
+	 * Start replication of the new item instance if bReplicateUsingRegisteredSubObjectList is enabled, but postpone
+	 * replication if the component is not ready for replication yet.
+	 */
+	if (IsValid(NewInstance) && IsUsingRegisteredSubObjectList() && IsReadyForReplication())
+	{
+		AddItemInstanceReplicatedSubObject(NewInstance);
+	}
+
+	if (IsValid(NewInstance) && ItemIndexSubsystem.IsValid())
+	{
+		ItemIndexSubsystem->AddItems(this, NewInstance->GetDefinition(), NewInstance->GetStackCount());
+	}
+
+	OnContentChanged.Broadcast(FInventoryContentChange(InventoryContent[SlotsArrayIndex].TypeTag, SlotIndex,
+		OldInstance, NewInstance));
+}
+
+void UInventoryManagerComponent::SetItemStackCount(const int32 SlotsArrayIndex, const int32 SlotIndex,
+	const int32 NewStackCount)
+{
+	UInventoryItemInstance* ItemInstance = InventoryContent.GetInstance(SlotsArrayIndex, SlotIndex);
+
+#if DO_CHECK
+	check(IsValid(ItemInstance));
+#endif
+
+	const int32 OldStackCount = ItemInstance->GetStackCount();
+
+	// Only the stat of the item instance is changed here, so the slots arrays don't need to be replicated again
+	ItemInstance->SetStackCount(NewStackCount);
+
+	if (ItemIndexSubsystem.IsValid())
+	{
+		if (NewStackCount > OldStackCount)
+		{
+			ItemIndexSubsystem->AddItems(this, ItemInstance->GetDefinition(), NewStackCount - OldStackCount);
+		}
+		else
+		{
+			ItemIndexSubsystem->RemoveItems(this, ItemInstance->GetDefinition(), OldStackCount - NewStackCount);
+		}
+	}
+
+	OnContentChanged.Broadcast(FInventoryContentChange(InventoryContent[SlotsArrayIndex].TypeTag, SlotIndex,
+		ItemInstance, ItemInstance));
+}
+
+bool UInventoryManagerComponent::AddItem(const UInventoryItemInstance* ItemInstance, const int32 SlotIndex,
 	const FGameplayTag& SlotTypeTag)
+{
+	return AddItemInternal(ItemInstance, nullptr, SlotIndex, SlotTypeTag);
+}
+
+bool UInventoryManagerComponent::AddItemInstance(UInventoryItemInstance* ItemInstance, const int32 SlotIndex,
+	const FGameplayTag& SlotTypeTag)
+{
+#if DO_CHECK
+	check(IsValid(ItemInstance));
+	checkf(ItemInstance->GetOuter() == this, TEXT("The item must be created with the inventory as the Outer"));
+#endif
+
+	return AddItemInternal(ItemInstance, ItemInstance, SlotIndex, SlotTypeTag);
+}
+
+bool UInventoryManagerComponent::AddItemInternal(const UInventoryItemInstance* ItemInstance,
+	UInventoryItemInstance* OwnedItemInstance, int32 SlotIndex, const FGameplayTag& SlotTypeTag)
 {
 #if DO_CHECK
 	check(IsValid(ItemInstance));
@@ -132,57 +588,165 @@ bool UInventoryManagerComponent::AddItem(const UInventoryItemInstance* ItemInsta
 	ensureAlways(GetOwner()->HasAuthority());
 #endif
 
-	// Find which inventory array corresponds to the requested slot type
-	const int32 SlotsArrayIndex = InventoryContent.IndexOfByTag(SlotTypeTag);
-
-	const bool bSlotsTypeValid = !ensureAlwaysMsgf(SlotsArrayIndex != INDEX_NONE,
-		TEXT("Failed to find a slots array by tag %s"), *SlotTypeTag.ToString());
+	const int32 SlotsArrayIndex = GetSlotsArrayIndex(SlotTypeTag);
 
-	if (bSlotsTypeValid)
+	if (SlotsArrayIndex == INDEX_NONE)
 	{
 		return false;
 	}
 
 	const FInventorySlotsArray& SlotsArray = InventoryContent[SlotsArrayIndex].Array;
 
-	// Automatic search for empty slot
-	if (SlotIndex == INDEX_NONE || !ensureAlways(SlotsArray.GetItems().IsValidIndex(SlotIndex)))
+	const int32 MaxStackCount = ItemInstance->GetMaxStackCount();
+	int32 RemainingCount = ItemInstance->GetStackCount();
+
+	// === Add to the requested slot ===
+
+	if (SlotIndex != INDEX_NONE && ensureAlways(SlotsArray.IsValidSlotIndex(SlotIndex)))
+	{
+		UInventoryItemInstance* SlotInstance = SlotsArray.GetInstance(SlotIndex);
+
+		// Merge into the stack in the requested slot if the whole item fits there
+		if (IsValid(SlotInstance) && SlotInstance->CanStackWith(ItemInstance) &&
+			SlotInstance->GetStackCount() + RemainingCount <= MaxStackCount)
+		{
+			SetItemStackCount(SlotsArrayIndex, SlotIndex, SlotInstance->GetStackCount() + RemainingCount);
+
+			return true;
+		}
+
+		if (!ensureAlways(!IsValid(SlotInstance)) || !ensureAlways(RemainingCount <= MaxStackCount))
+		{
+			return false;
+		}
+
+		/**
+		 * TODO: Potential memory leak if you assign the component as the Outer due to UE bug UE-127172. Lyra circumvents
+		 * this by setting the component's owner as the Outer instead. Consider implementing a subsystem to manage the
+		 * item instance lifecycle explicitly. This would be more robust from an architectural standpoint but is also
+		 * more complex. There may be no issue in practice, but this should be verified.
+		 */
+		UInventoryItemInstance* NewSlotInstance = OwnedItemInstance ?
+			OwnedItemInstance : ItemInstance->Duplicate(this);
+
+#if DO_CHECK
+		check(IsValid(NewSlotInstance))
+#endif
+
+		SetSlotInstance(NewSlotInstance, SlotsArrayIndex, SlotIndex);
+
+		return true;
+	}
+
+	// === Automatic search for existing stacks and empty slots ===
+
+	// Slots with stacks of the same item that still have some free space
+	TArray<int32, TInlineAllocator<8>> StacksSlotIndices;
+
+	TArray<int32, TInlineAllocator<8>> EmptySlotIndices;
+
+	int32 FreeSpaceInStacks = 0;
+
+	for (int32 Index = 0; Index < SlotsArray.GetItems().Num(); ++Index)
 	{
-		SlotIndex = SlotsArray.GetEmptySlotIndex();
+		const UInventoryItemInstance* SlotInstance = SlotsArray.GetInstance(Index);
+
+		if (!IsValid(SlotInstance))
+		{
+			EmptySlotIndices.Add(Index);
+		}
+		else if (SlotInstance->CanStackWith(ItemInstance) && SlotInstance->GetStackCount() < MaxStackCount)
+		{
+			StacksSlotIndices.Add(Index);
+			FreeSpaceInStacks += MaxStackCount - SlotInstance->GetStackCount();
+		}
 	}
 
-	if (SlotIndex == INDEX_NONE || !ensureAlways(SlotsArray.IsSlotEmpty(SlotIndex)))
+	const int32 RequiredEmptySlotsNumber =
+		FMath::DivideAndRoundUp(FMath::Max(RemainingCount - FreeSpaceInStacks, 0), MaxStackCount);
+
+	// Don't add anything if the whole item doesn't fit
+	if (RequiredEmptySlotsNumber > EmptySlotIndices.Num())
 	{
 		return false;
 	}
 
-	/**
-	 * TODO: Potential memory leak if you assign the component as the Outer due to UE bug UE-127172. Lyra circumvents
-	 * this by setting the component's owner as the Outer instead. Consider implementing a subsystem to manage the item
-	 * instance lifecycle explicitly. This would be more robust from an architectural standpoint but is also more
-	 * complex. There may be no issue in practice, but this should be verified.
-	 */
-	UInventoryItemInstance* ItemInstanceDuplicate = ItemInstance->Duplicate(this);
+	// Fill the existing stacks first. Only the stack count stat changes here, so no new objects are created.
+	for (const int32 StackSlotIndex : StacksSlotIndices)
+	{
+		if (RemainingCount <= 0)
+		{
+			break;
+		}
+
+		UInventoryItemInstance* SlotInstance = SlotsArray.GetInstance(StackSlotIndex);
+
+		const int32 AddedCount = FMath::Min(RemainingCount, MaxStackCount - SlotInstance->GetStackCount());
+		SetItemStackCount(SlotsArrayIndex, StackSlotIndex, SlotInstance->GetStackCount() + AddedCount);
+
+		RemainingCount -= AddedCount;
+	}
+
+	// Put the rest of the items into the empty slots
+	for (int32 i = 0; i < RequiredEmptySlotsNumber; ++i)
+	{
+		// The owned item can only be used once. The duplicates of it get their stack count set below anyway.
+		UInventoryItemInstance* NewSlotInstance = OwnedItemInstance && i == 0 ?
+			OwnedItemInstance : ItemInstance->Duplicate(this);
 
 #if DO_CHECK
-	check(IsValid(ItemInstanceDuplicate))
+		check(IsValid(NewSlotInstance))
 #endif
 
-	// Assign the duplicated item instance to the target slot
-	InventoryContent.SetInstance(ItemInstanceDuplicate, SlotsArrayIndex, SlotIndex);
+		const int32 StackCount = FMath::Min(RemainingCount, MaxStackCount);
 
-	/**
-	 * Start replication item instance if bReplicateUsingRegisteredSubObjectList is enabled, but postpone replication
-	 * if the component is not ready for replication yet.
-	*/
-	if (IsUsingRegisteredSubObjectList() && IsReadyForReplication())
+		if (NewSlotInstance->IsStackable())
+		{
+			NewSlotInstance->SetStackCount(StackCount);
+		}
+
+		SetSlotInstance(NewSlotInstance, SlotsArrayIndex, EmptySlotIndices[i]);
+
+		RemainingCount -= StackCount;
+	}
+
+	return true;
+}
+
+int32 UInventoryManagerComponent::GetFreeSpaceFor(const UInventoryItemInstance* ItemInstance,
+	const FGameplayTag& SlotTypeTag) const
+{
+#if DO_CHECK
+	check(IsValid(ItemInstance));
+#endif
+
+	const int32 SlotsArrayIndex = GetSlotsArrayIndex(SlotTypeTag);
+
+	if (SlotsArrayIndex == INDEX_NONE)
 	{
-		AddReplicatedSubObject(ItemInstanceDuplicate);
+		return 0;
 	}
 
-	OnContentChanged.Broadcast();
+	const FInventorySlotsArray& SlotsArray = InventoryContent[SlotsArrayIndex].Array;
 
-	return true;
+	const int32 MaxStackCount = ItemInstance->GetMaxStackCount();
+	int32 FreeSpace = 0;
+
+	for (int32 Index = 0; Index < SlotsArray.GetItems().Num(); ++Index)
+	{
+		const UInventoryItemInstance* SlotInstance = SlotsArray.GetInstance(Index);
+
+		if (!IsValid(SlotInstance))
+		{
+			FreeSpace += MaxStackCount;
+		}
+		else if (SlotInstance->CanStackWith(ItemInstance))
+		{
+			FreeSpace += FMath::Max(MaxStackCount - SlotInstance->GetStackCount(), 0);
+		}
+	}
+
+	return FreeSpace;
 }
 
 bool UInventoryManagerComponent::DeleteItem(const int32 SlotIndex, const FGameplayTag& SlotTypeTag)
@@ -191,13 +755,9 @@ bool UInventoryManagerComponent::DeleteItem(const int32 SlotIndex, const FGamepl
 	ensureAlways(GetOwner()->HasAuthority());
 #endif
 
-	// Find which inventory array corresponds to the requested slot type
-	const int32 SlotsArrayIndex = InventoryContent.IndexOfByTag(SlotTypeTag);
-
-	const bool bSlotsTypeValid = !ensureAlwaysMsgf(SlotsArrayIndex != INDEX_NONE,
-		TEXT("Failed to find a slots array by tag %s"), *SlotTypeTag.ToString());
+	const int32 SlotsArrayIndex = GetSlotsArrayIndex(SlotTypeTag);
 
-	if (bSlotsTypeValid)
+	if (SlotsArrayIndex == INDEX_NONE)
 	{
 		return false;
 	}
@@ -213,30 +773,258 @@ bool UInventoryManagerComponent::DeleteItem(const int32 SlotIndex, const FGamepl
 		return false;
 	}
 
-	UInventoryItemInstance* ItemInstance = SlotsArray.GetItems()[SlotIndex].Instance;
+	// Clear the slot by setting its instance to null
+	SetSlotInstance(nullptr, SlotsArrayIndex, SlotIndex);
+
+	return true;
+}
+
+bool UInventoryManagerComponent::SplitItem(const int32 SlotIndex, const int32 SplitCount, int32 TargetSlotIndex,
+	const FGameplayTag& SlotTypeTag)
+{
+#if DO_ENSURE
+	ensureAlways(GetOwner()->HasAuthority());
+#endif
+
+	const int32 SlotsArrayIndex = GetSlotsArrayIndex(SlotTypeTag);
+
+	if (SlotsArrayIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	const FInventorySlotsArray& SlotsArray = InventoryContent[SlotsArrayIndex].Array;
 
-	if (!ensureAlways(IsValid(ItemInstance)))
+#if DO_CHECK
+	checkf(SlotsArray.IsValidSlotIndex(SlotIndex), TEXT("Unavailable slot index"))
+#endif
+
+	UInventoryItemInstance* SourceInstance = SlotsArray.GetInstance(SlotIndex);
+
+	if (!IsValid(SourceInstance))
 	{
 		return false;
 	}
 
-	// Stop replication item instance if bReplicateUsingRegisteredSubObjectList is enabled
-	if (IsUsingRegisteredSubObjectList())
+	const int32 StackCount = SourceInstance->GetStackCount();
+
+	// Splitting nothing or the whole stack doesn't make any sense
+	if (SplitCount <= 0 || SplitCount >= StackCount)
 	{
-		RemoveReplicatedSubObject(ItemInstance);
+		return false;
 	}
 
-	// Clear the slot by setting its instance to null
-	InventoryContent.SetInstance(nullptr, SlotsArrayIndex, SlotIndex);
+	if (TargetSlotIndex == INDEX_NONE)
+	{
+		TargetSlotIndex = SlotsArray.GetEmptySlotIndex();
+	}
+
+	if (TargetSlotIndex == INDEX_NONE || !ensureAlways(SlotsArray.IsValidSlotIndex(TargetSlotIndex)) ||
+		!SlotsArray.IsSlotEmpty(TargetSlotIndex))
+	{
+		return false;
+	}
+
+	UInventoryItemInstance* SplitInstance = SourceInstance->Duplicate(this);
+
+#if DO_CHECK
+	check(IsValid(SplitInstance))
+#endif
+
+	SplitInstance->SetStackCount(SplitCount);
+	SetItemStackCount(SlotsArrayIndex, SlotIndex, StackCount - SplitCount);
+
+	SetSlotInstance(SplitInstance, SlotsArrayIndex, TargetSlotIndex);
+
+	return true;
+}
+
+bool UInventoryManagerComponent::MergeItems(const int32 SourceSlotIndex, const int32 TargetSlotIndex,
+	const FGameplayTag& SlotTypeTag)
+{
+#if DO_ENSURE
+	ensureAlways(GetOwner()->HasAuthority());
+#endif
+
+	const int32 SlotsArrayIndex = GetSlotsArrayIndex(SlotTypeTag);
+
+	if (SlotsArrayIndex == INDEX_NONE || SourceSlotIndex == TargetSlotIndex)
+	{
+		return false;
+	}
+
+	const FInventorySlotsArray& SlotsArray = InventoryContent[SlotsArrayIndex].Array;
+
+#if DO_CHECK
+	checkf(SlotsArray.IsValidSlotIndex(SourceSlotIndex), TEXT("Unavailable source slot index"))
+	checkf(SlotsArray.IsValidSlotIndex(TargetSlotIndex), TEXT("Unavailable target slot index"))
+#endif
+
+	UInventoryItemInstance* SourceInstance = SlotsArray.GetInstance(SourceSlotIndex);
+	UInventoryItemInstance* TargetInstance = SlotsArray.GetInstance(TargetSlotIndex);
+
+	if (!IsValid(SourceInstance) || !IsValid(TargetInstance) || !TargetInstance->CanStackWith(SourceInstance))
+	{
+		return false;
+	}
+
+	const int32 SourceStackCount = SourceInstance->GetStackCount();
+	const int32 TargetStackCount = TargetInstance->GetStackCount();
+
+	const int32 MovedCount = FMath::Min(SourceStackCount, TargetInstance->GetMaxStackCount() - TargetStackCount);
+
+	// The target stack is already full
+	if (MovedCount <= 0)
+	{
+		return false;
+	}
+
+	SetItemStackCount(SlotsArrayIndex, TargetSlotIndex, TargetStackCount + MovedCount);
+
+	if (MovedCount == SourceStackCount)
+	{
+		SetSlotInstance(nullptr, SlotsArrayIndex, SourceSlotIndex);
+	}
+	else
+	{
+		SetItemStackCount(SlotsArrayIndex, SourceSlotIndex, SourceStackCount - MovedCount);
+	}
+
+	return true;
+}
+
+bool UInventoryManagerComponent::MoveItem(const int32 SourceSlotIndex, const int32 TargetSlotIndex,
+	const FGameplayTag& SlotTypeTag)
+{
+#if DO_ENSURE
+	ensureAlways(GetOwner()->HasAuthority());
+#endif
+
+	const int32 SlotsArrayIndex = GetSlotsArrayIndex(SlotTypeTag);
+
+	if (SlotsArrayIndex == INDEX_NONE || SourceSlotIndex == TargetSlotIndex)
+	{
+		return false;
+	}
+
+	const FInventorySlotsArray& SlotsArray = InventoryContent[SlotsArrayIndex].Array;
+
+#if DO_CHECK
+	checkf(SlotsArray.IsValidSlotIndex(SourceSlotIndex), TEXT("Unavailable source slot index"))
+	checkf(SlotsArray.IsValidSlotIndex(TargetSlotIndex), TEXT("Unavailable target slot index"))
+#endif
+
+	UInventoryItemInstance* SourceInstance = SlotsArray.GetInstance(SourceSlotIndex);
+
+	if (!IsValid(SourceInstance) || !SlotsArray.IsSlotEmpty(TargetSlotIndex))
+	{
+		return false;
+	}
+
+	// The same item instance is moved, so its stats are kept as they are
+	SetSlotInstance(nullptr, SlotsArrayIndex, SourceSlotIndex);
+	SetSlotInstance(SourceInstance, SlotsArrayIndex, TargetSlotIndex);
+
+	return true;
+}
+
+bool UInventoryManagerComponent::ConsumeItem(const int32 SlotIndex, const int32 Count, const FGameplayTag& SlotTypeTag)
+{
+#if DO_ENSURE
+	ensureAlways(GetOwner()->HasAuthority());
+#endif
+
+	const int32 SlotsArrayIndex = GetSlotsArrayIndex(SlotTypeTag);
+
+	if (SlotsArrayIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	const FInventorySlotsArray& SlotsArray = InventoryContent[SlotsArrayIndex].Array;
+
+#if DO_CHECK
+	checkf(SlotsArray.IsValidSlotIndex(SlotIndex), TEXT("Unavailable slot index"))
+#endif
+
+	UInventoryItemInstance* ItemInstance = SlotsArray.GetInstance(SlotIndex);
 
-	OnContentChanged.Broadcast();
+	if (!IsValid(ItemInstance))
+	{
+		return false;
+	}
+
+	const int32 StackCount = ItemInstance->GetStackCount();
+
+	if (!ensureAlways(Count > 0 && Count <= StackCount))
+	{
+		return false;
+	}
+
+	// Clear the slot if the whole stack was consumed
+	if (Count == StackCount)
+	{
+		SetSlotInstance(nullptr, SlotsArrayIndex, SlotIndex);
+	}
+	else
+	{
+		SetItemStackCount(SlotsArrayIndex, SlotIndex, StackCount - Count);
+	}
 
 	return true;
 }
 
-void UInventoryManagerComponent::OnRep_InventoryContent(FInventorySlotsTypedArrayContainer& Test) const
+bool UInventoryManagerComponent::SetItemInstanceStat(const int32 SlotIndex, const FInstanceStatsItem& Stat,
+	const FGameplayTag& SlotTypeTag)
 {
-	OnContentChanged.Broadcast();
+#if DO_ENSURE
+	ensureAlways(GetOwner()->HasAuthority());
+#endif
+
+	const int32 SlotsArrayIndex = GetSlotsArrayIndex(SlotTypeTag);
+
+	if (SlotsArrayIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	const FInventorySlotsArray& SlotsArray = InventoryContent[SlotsArrayIndex].Array;
+
+#if DO_CHECK
+	checkf(SlotsArray.IsValidSlotIndex(SlotIndex), TEXT("Unavailable slot index"))
+#endif
+
+	UInventoryItemInstance* ItemInstance = SlotsArray.GetInstance(SlotIndex);
+
+	if (!IsValid(ItemInstance))
+	{
+		return false;
+	}
+
+	// The stack count must stay in sync with the item index
+	if (Stat.Tag == InventorySystemGameplayTags::Inventory_Item_Stat_StackCount)
+	{
+		const int32 NewStackCount = FMath::RoundToInt32(Stat.Value);
+
+		// An empty stack means there is no item anymore
+		if (NewStackCount <= 0)
+		{
+			SetSlotInstance(nullptr, SlotsArrayIndex, SlotIndex);
+
+			return true;
+		}
+
+		SetItemStackCount(SlotsArrayIndex, SlotIndex, FMath::Min(NewStackCount, ItemInstance->GetMaxStackCount()));
+
+		return true;
+	}
+
+	ItemInstance->SetInstanceStat(Stat);
+
+	OnContentChanged.Broadcast(FInventoryContentChange(SlotTypeTag, SlotIndex, ItemInstance, ItemInstance,
+		EInventoryContentChangeType::StatChanged));
+
+	return true;
 }
 
 #if WITH_EDITORONLY_DATA && !NO_LOGGING
@@ -269,8 +1057,8 @@ void UInventoryManagerComponent::LogInventoryContent() const
 				continue;
 			}
 
-			Output += FString::Printf(TEXT("%02d: %s (Class: %s | Instance: %p)\n"), i, *Item->GetName(),
-				*Item->GetClass()->GetName(), Item);
+			Output += FString::Printf(TEXT("%02d: %s x%d (Class: %s | Instance: %p)\n"), i, *Item->GetName(),
+				Item->GetStackCount(), *Item->GetClass()->GetName(), Item);
 		}
 
 		Output += Separator;
@@ -2,21 +2,39 @@
 
 #include "Actors/InventoryPickupItem.h"
 
+#include "InventorySystem.h"
+#include "TimerManager.h"
 #include "ActorComponents/InventoryManagerComponent.h"
-#include "Engine/ActorChannel.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
 #include "Net/UnrealNetwork.h"
+#include "Objects/InventoryItemDefinition.h"
 #include "Objects/InventoryItemInstance.h"
 #include "Objects/InventoryItemFragments/PickupInventoryItemFragment.h"
+#include "Subsystems/InventoryItemIndexSubsystem.h"
+#include "Subsystems/InventoryPickupItemPoolSubsystem.h"
+
+static TAutoConsoleVariable<bool> CVarPickupRestDormancy(
+	TEXT("Inventory.Pickups.RestDormancy"),
+	true,
+	TEXT("Whether pickups put their physics body to sleep and become net dormant when they come to rest."));
 
 AInventoryPickupItem::AInventoryPickupItem()
 {
 	PrimaryActorTick.bCanEverTick = false;
 
 	bReplicates = true;
+	bReplicateUsingRegisteredSubObjectList = true;
+
+	// Pooled actors are reused at different locations, so clients have to receive the new transform
+	SetReplicatingMovement(true);
 
 	MeshComponent = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("Mesh"));
 	MeshComponent->SetSimulatePhysics(true);
 
+	// Required to know when the body is woken up by something touching it
+	MeshComponent->BodyInstance.bGenerateWakeEvents = true;
+
 	SetRootComponent(MeshComponent); 
 }
 
@@ -24,20 +42,12 @@ void AInventoryPickupItem::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>&
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-	DOREPLIFETIME(ThisClass, ItemInstance);
-}
-
-bool AInventoryPickupItem::ReplicateSubobjects(class UActorChannel* Channel, class FOutBunch* Bunch,
-	FReplicationFlags* RepFlags)
-{
-	bool bParentResult = Super::ReplicateSubobjects(Channel, Bunch, RepFlags);
+	// Idle pickups never change, so they are only compared when something is marked dirty
+	FDoRepLifetimeParams Params;
+	Params.bIsPushBased = true;
 
-	if (ItemInstance)
-	{
-		bParentResult |= Channel->ReplicateSubobject(ItemInstance, *Bunch, *RepFlags);
-	}
-	
-	return bParentResult;
+	DOREPLIFETIME_WITH_PARAMS_FAST(ThisClass, ItemInstance, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(ThisClass, bInPool, Params);
 }
 
 void AInventoryPickupItem::OnConstruction(const FTransform& Transform)
@@ -62,14 +72,68 @@ void AInventoryPickupItem::BeginPlay()
 	check(ItemInstance)
 #endif
 
-	if (HasAuthority() && !ItemInstance->IsInitialized())
+	if (!HasAuthority())
+	{
+		return;
+	}
+
+	if (!ItemInstance->IsInitialized())
 	{
 		ItemInstance->Initialize();
 	}
+
+	AddReplicatedSubObject(ItemInstance);
+
+	RegisterInItemIndex();
+
+	MeshComponent->OnComponentSleep.AddDynamic(this, &ThisClass::OnMeshSleep);
+	MeshComponent->OnComponentWake.AddDynamic(this, &ThisClass::OnMeshWake);
+
+	StartRestCheck();
 }
 
-bool AInventoryPickupItem::ApplyChangesFromItemInstance() const
+void AInventoryPickupItem::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
+	UnregisterFromItemIndex();
+
+	CancelMeshLoading();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void AInventoryPickupItem::RegisterInItemIndex()
+{
+#if DO_CHECK
+	check(ItemInstance);
+#endif
+
+#if DO_ENSURE
+	ensureAlways(!ItemIndexSubsystem.IsValid());
+#endif
+
+	ItemIndexSubsystem = GetWorld()->GetSubsystem<UInventoryItemIndexSubsystem>();
+
+	if (ItemIndexSubsystem.IsValid())
+	{
+		ItemIndexSubsystem->AddItems(this, ItemInstance->GetDefinition(), ItemInstance->GetStackCount());
+	}
+}
+
+void AInventoryPickupItem::UnregisterFromItemIndex()
+{
+	if (ItemIndexSubsystem.IsValid())
+	{
+		ItemIndexSubsystem->RemoveItems(this, ItemInstance->GetDefinition(), ItemInstance->GetStackCount());
+	}
+
+	ItemIndexSubsystem.Reset();
+}
+
+bool AInventoryPickupItem::ApplyChangesFromItemInstance()
+{
+	// The mesh that was requested for the previous item instance is no longer needed
+	CancelMeshLoading();
+
 	if (!ItemInstance)
 	{
 		return false;
@@ -86,19 +150,66 @@ bool AInventoryPickupItem::ApplyChangesFromItemInstance() const
 		return false;
 	}
 
-	UStaticMesh* StaticMesh = PickupInventoryItemFragment->GetMesh();
+	const TSoftObjectPtr<UStaticMesh>& StaticMesh = PickupInventoryItemFragment->GetMesh();
 
-	if (!IsValid(StaticMesh))
+	if (StaticMesh.IsNull())
 	{
 		return false;
 	}
 
-	MeshComponent->SetStaticMesh(StaticMesh);
+	// The mesh is already in memory (e.g., other pickups of the same item use it)
+	if (StaticMesh.IsValid())
+	{
+		MeshComponent->SetStaticMesh(StaticMesh.Get());
+
+		return true;
+	}
+
+	/**
+	 * The authority simulates the physics of the pickup that is replicated to the clients, so its collision must match
+	 * the real mesh from the start. Editor previews of the assets can't wait for the async loading either.
+	 */
+	if (HasAuthority() || !GetWorld() || !GetWorld()->IsGameWorld())
+	{
+		MeshComponent->SetStaticMesh(StaticMesh.LoadSynchronous());
+
+		return true;
+	}
+
+	// Show the mesh of the CDO as a placeholder until the mesh is loaded
+	SetDefaultSettings();
+
+	LoadMeshHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(StaticMesh.ToSoftObjectPath(),
+		FStreamableDelegate::CreateUObject(this, &ThisClass::OnMeshLoaded));
 
 	return true;
 }
 
-void AInventoryPickupItem::SetDefaultSettings() const
+void AInventoryPickupItem::CancelMeshLoading()
+{
+	if (LoadMeshHandle.IsValid())
+	{
+		LoadMeshHandle->CancelHandle();
+		LoadMeshHandle.Reset();
+	}
+}
+
+void AInventoryPickupItem::OnMeshLoaded()
+{
+	// The handle is canceled whenever the item instance changes, so the loaded mesh always belongs to the current one
+	UStaticMesh* LoadedMesh = Cast<UStaticMesh>(LoadMeshHandle->GetLoadedAsset());
+
+	// The mesh component references the loaded mesh from now on, so the handle isn't needed to keep it in memory
+	LoadMeshHandle.Reset();
+
+	// Keep the placeholder if the mesh failed to load
+	if (IsValid(LoadedMesh))
+	{
+		MeshComponent->SetStaticMesh(LoadedMesh);
+	}
+}
+
+void AInventoryPickupItem::SetDefaultSettings()
 {
 	const AInventoryPickupItem* PickupItemCDO = GetClass()->GetDefaultObject<AInventoryPickupItem>();
 
@@ -124,7 +235,7 @@ void AInventoryPickupItem::SetDefaultSettings() const
 	}
 }
 
-void AInventoryPickupItem::TryApplyChangesFromItemInstance() const
+void AInventoryPickupItem::TryApplyChangesFromItemInstance()
 {
 	// Try to apply the new settings and fall back to the default ones if failed to apply the new ones
 	if (!ApplyChangesFromItemInstance())
@@ -148,9 +259,245 @@ void AInventoryPickupItem::Pickup(UInventoryManagerComponent* InventoryManagerCo
 #if DO_ENSURE
 	ensureAlways(HasAuthority());
 #endif
+
+	// The item is about to change, so the actor must replicate again even if the pickup fails
+	WakeFromRest();
 	
-	if (InventoryManagerComponent->AddItem(ItemInstance))
+	if (bInPool || !InventoryManagerComponent->AddItem(ItemInstance))
+	{
+		return;
+	}
+
+	UInventoryPickupItemPoolSubsystem* PickupItemPoolSubsystem =
+		GetWorld()->GetSubsystem<UInventoryPickupItemPoolSubsystem>();
+
+	if (IsValid(PickupItemPoolSubsystem))
+	{
+		PickupItemPoolSubsystem->ReleasePickupItem(this);
+	}
+	else
 	{
 		Destroy();
 	}
 }
+
+void AInventoryPickupItem::ActivateFromPool(UInventoryItemInstance* InItemInstance, const FTransform& Transform)
+{
+#if DO_CHECK
+	check(IsValid(InItemInstance));
+#endif
+
+#if DO_ENSURE
+	ensureAlways(HasAuthority());
+	ensureAlways(bInPool);
+#endif
+
+	// Wake up the actor before changing anything, so the changes are replicated to clients
+	SetNetDormancy(DORM_Awake);
+
+	RemoveReplicatedSubObject(ItemInstance);
+
+	ItemInstance = InItemInstance;
+	MARK_PROPERTY_DIRTY_FROM_NAME(ThisClass, ItemInstance, this);
+
+	AddReplicatedSubObject(ItemInstance);
+
+	if (!ItemInstance->IsInitialized())
+	{
+		ItemInstance->Initialize();
+	}
+
+	TryApplyChangesFromItemInstance();
+
+	SetActorTransform(Transform, false, nullptr, ETeleportType::ResetPhysics);
+
+	bInPool = false;
+	MARK_PROPERTY_DIRTY_FROM_NAME(ThisClass, bInPool, this);
+	ApplyPoolState();
+
+	RegisterInItemIndex();
+
+	ForceNetUpdate();
+
+	StartRestCheck();
+}
+
+void AInventoryPickupItem::DeactivateToPool()
+{
+#if DO_ENSURE
+	ensureAlways(HasAuthority());
+	ensureAlways(!bInPool);
+#endif
+
+	// Let the pool state replicate even if the actor is already dormant because it was resting
+	FlushNetDormancy();
+
+	GetWorldTimerManager().ClearTimer(RestCheckTimerHandle);
+	bResting = false;
+
+	UnregisterFromItemIndex();
+
+	bInPool = true;
+	MARK_PROPERTY_DIRTY_FROM_NAME(ThisClass, bInPool, this);
+	ApplyPoolState();
+
+	/**
+	 * Replicate the pool state one last time and stop considering the actor for replication. Dormancy is used instead
+	 * of turning the replication off because it keeps the actor channel, so the actor doesn't have to be respawned on
+	 * clients when it's taken from the pool again.
+	 */
+	ForceNetUpdate();
+	SetNetDormancy(DORM_DormantAll);
+}
+
+void AInventoryPickupItem::OnRep_InPool()
+{
+	ApplyPoolState();
+}
+
+void AInventoryPickupItem::ApplyPoolState()
+{
+	// Hidden state is applied on both server and clients because clients may receive bInPool before bHidden
+	SetActorHiddenInGame(bInPool);
+
+	if (bInPool)
+	{
+		MeshComponent->SetSimulatePhysics(false);
+
+		// Turning the collision off stops traces against the pooled actor, and interaction managers skip hidden actors
+		MeshComponent->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+
+		return;
+	}
+
+	const UStaticMeshComponent* DefaultMeshComponent = GetClass()->GetDefaultObject<AInventoryPickupItem>()->GetMesh();
+
+	MeshComponent->SetCollisionEnabled(DefaultMeshComponent->GetCollisionEnabled());
+	MeshComponent->SetSimulatePhysics(DefaultMeshComponent->BodyInstance.bSimulatePhysics);
+}
+
+void AInventoryPickupItem::StartRestCheck()
+{
+	if (CVarPickupRestDormancy.GetValueOnGameThread())
+	{
+		GetWorldTimerManager().SetTimer(RestCheckTimerHandle, this, &ThisClass::CheckRest, RestCheckInterval,
+			true);
+	}
+}
+
+void AInventoryPickupItem::CheckRest()
+{
+	if (bInPool || !MeshComponent->IsSimulatingPhysics())
+	{
+		GetWorldTimerManager().ClearTimer(RestCheckTimerHandle);
+
+		return;
+	}
+
+	const bool bLinearRest = MeshComponent->GetPhysicsLinearVelocity().SizeSquared() <=
+		FMath::Square(RestLinearSpeedThreshold);
+
+	const bool bAngularRest = MeshComponent->GetPhysicsAngularVelocityInDegrees().SizeSquared() <=
+		FMath::Square(RestAngularSpeedThreshold);
+
+	if (bLinearRest && bAngularRest)
+	{
+		// Don't wait for the physics engine to put the body to sleep by its own (much stricter) thresholds
+		MeshComponent->PutRigidBodyToSleep();
+
+		EnterRest();
+	}
+}
+
+void AInventoryPickupItem::EnterRest()
+{
+	if (bInPool || bResting)
+	{
+		return;
+	}
+
+	bResting = true;
+
+	GetWorldTimerManager().ClearTimer(RestCheckTimerHandle);
+
+	// Replicate the final transform and stop considering the actor for replication until it's woken up
+	ForceNetUpdate();
+	SetNetDormancy(DORM_DormantAll);
+}
+
+void AInventoryPickupItem::WakeFromRest()
+{
+	if (bInPool || !bResting)
+	{
+		return;
+	}
+
+	bResting = false;
+
+	SetNetDormancy(DORM_Awake);
+
+	StartRestCheck();
+}
+
+void AInventoryPickupItem::OnMeshSleep(UPrimitiveComponent* SleepingComponent, FName BoneName)
+{
+	EnterRest();
+}
+
+void AInventoryPickupItem::OnMeshWake(UPrimitiveComponent* WakingComponent, FName BoneName)
+{
+	WakeFromRest();
+}
+
+#if !UE_BUILD_SHIPPING
+/**
+ * Spawns pickups in a grid around the world origin to compare the server tick and bandwidth (stat unit, stat net) once
+ * they come to rest with Inventory.Pickups.RestDormancy turned on and off. Must be run on the server (e.g., a headless
+ * dedicated server).
+ * Usage: Inventory.Pickups.SpawnBenchmark <PickupClassPath> <ItemDefinitionClassPath> [Count]
+ */
+static FAutoConsoleCommandWithWorldAndArgs InventoryPickupsSpawnBenchmarkCommand(
+	TEXT("Inventory.Pickups.SpawnBenchmark"),
+	TEXT("Spawns the given number of pickups (1000 by default) in a grid around the world origin."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (Args.Num() < 2 || World->GetNetMode() == NM_Client)
+		{
+			return;
+		}
+
+		const TSubclassOf<AInventoryPickupItem> PickupItemClass = StaticLoadClass(AInventoryPickupItem::StaticClass(),
+			nullptr, *Args[0]);
+
+		const TSubclassOf<UInventoryItemDefinition> DefinitionClass = StaticLoadClass(
+			UInventoryItemDefinition::StaticClass(), nullptr, *Args[1]);
+
+		UInventoryPickupItemPoolSubsystem* PickupItemPoolSubsystem =
+			World->GetSubsystem<UInventoryPickupItemPoolSubsystem>();
+
+		if (!PickupItemClass || !DefinitionClass || !IsValid(PickupItemPoolSubsystem))
+		{
+			UE_LOG(LogInventorySystem, Warning, TEXT("Inventory.Pickups.SpawnBenchmark: Invalid arguments"));
+
+			return;
+		}
+
+		const int32 Count = Args.Num() > 2 ? FMath::Max(FCString::Atoi(*Args[2]), 1) : 1000;
+		const int32 GridSize = FMath::CeilToInt(FMath::Sqrt(static_cast<float>(Count)));
+
+		UInventoryItemInstance* ItemTemplate = NewObject<UInventoryItemInstance>(PickupItemPoolSubsystem);
+		ItemTemplate->Initialize(DefinitionClass);
+
+		const double StartTime = FPlatformTime::Seconds();
+
+		for (int32 i = 0; i < Count; ++i)
+		{
+			const FVector Location(i % GridSize * 100, i / GridSize * 100, 100);
+
+			PickupItemPoolSubsystem->AcquirePickupItem(PickupItemClass, ItemTemplate, FTransform(Location));
+		}
+
+		UE_LOG(LogInventorySystem, Display, TEXT("Inventory.Pickups.SpawnBenchmark: Spawned %d pickups in %.3f ms"),
+			Count, (FPlatformTime::Seconds() - StartTime) * 1000.0);
+	}));
+#endif
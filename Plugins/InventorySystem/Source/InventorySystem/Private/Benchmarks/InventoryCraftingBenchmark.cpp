@@ -0,0 +1,140 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#if !UE_BUILD_SHIPPING
+
+#include "InventorySystem.h"
+#include "Common/DataAssets/InventoryCraftingRecipe.h"
+#include "Objects/InventoryItemDefinition.h"
+#include "Subsystems/InventoryCraftingSubsystem.h"
+
+// Creates transient recipes from the loaded item definitions and compares the index with a brute-force matching
+struct FInventoryCraftingBenchmark
+{
+	static bool CanCraft(const UInventoryCraftingRecipe* Recipe,
+		const TMap<TSubclassOf<UInventoryItemDefinition>, int32>& Items)
+	{
+		for (const TPair<TSubclassOf<UInventoryItemDefinition>, int32>& Ingredient : Recipe->GetIngredients())
+		{
+			if (Items.FindRef(Ingredient.Key) < Ingredient.Value)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	static void Run(const int32 RecipesNumber, const int32 SlotsNumber, const int32 NumIterations)
+	{
+		TArray<UClass*> DefinitionClasses;
+		GetDerivedClasses(UInventoryItemDefinition::StaticClass(), DefinitionClasses);
+
+		DefinitionClasses.RemoveAll([](const UClass* Class)
+		{
+			return Class->HasAnyClassFlags(CLASS_Abstract | CLASS_Deprecated | CLASS_NewerVersionExists);
+		});
+
+		if (DefinitionClasses.Num() < 2)
+		{
+			UE_LOG(LogInventorySystem, Warning,
+				TEXT("Inventory.Crafting.Benchmark: At least 2 item definitions must be loaded"));
+
+			return;
+		}
+
+		// A separate subsystem object keeps the benchmark recipes away from the real ones
+		UInventoryCraftingSubsystem* CraftingSubsystem = NewObject<UInventoryCraftingSubsystem>(GetTransientPackage());
+
+		FRandomStream RandomStream(RecipesNumber);
+		TArray<const UInventoryCraftingRecipe*> Recipes;
+
+		for (int32 i = 0; i < RecipesNumber; ++i)
+		{
+			TMap<TSubclassOf<UInventoryItemDefinition>, int32> Ingredients;
+			const int32 IngredientsNumber = RandomStream.RandRange(1, FMath::Min(4, DefinitionClasses.Num()));
+
+			while (Ingredients.Num() < IngredientsNumber)
+			{
+				Ingredients.Add(DefinitionClasses[RandomStream.RandHelper(DefinitionClasses.Num())],
+					RandomStream.RandRange(1, 3));
+			}
+
+			UInventoryCraftingRecipe* Recipe = NewObject<UInventoryCraftingRecipe>(CraftingSubsystem);
+			Recipe->Initialize(Ingredients, DefinitionClasses[RandomStream.RandHelper(DefinitionClasses.Num())]);
+
+			CraftingSubsystem->RegisterRecipe(Recipe);
+			Recipes.Add(Recipe);
+		}
+
+		// Emulate a full inventory
+		TMap<TSubclassOf<UInventoryItemDefinition>, int32> Items;
+
+		for (int32 i = 0; i < SlotsNumber; ++i)
+		{
+			Items.FindOrAdd(DefinitionClasses[RandomStream.RandHelper(DefinitionClasses.Num())]) +=
+				RandomStream.RandRange(1, 5);
+		}
+
+		TArray<const UInventoryCraftingRecipe*> CraftableRecipes;
+		int32 IndexedChecksum = 0;
+
+		const double IndexedStartTime = FPlatformTime::Seconds();
+
+		for (int32 i = 0; i < NumIterations; ++i)
+		{
+			CraftingSubsystem->GetCraftableRecipes(Items, CraftableRecipes);
+			IndexedChecksum += CraftableRecipes.Num();
+
+			IndexedChecksum += CraftingSubsystem->FindRecipeByIngredients(Recipes[i % Recipes.Num()]->GetIngredients())
+				!= nullptr;
+		}
+
+		const double IndexedTime = FPlatformTime::Seconds() - IndexedStartTime;
+
+		int32 BruteForceChecksum = 0;
+		const double BruteForceStartTime = FPlatformTime::Seconds();
+
+		for (int32 i = 0; i < NumIterations; ++i)
+		{
+			const TMap<TSubclassOf<UInventoryItemDefinition>, int32>& ExactIngredients =
+				Recipes[i % Recipes.Num()]->GetIngredients();
+
+			bool bFoundExactRecipe = false;
+
+			for (const UInventoryCraftingRecipe* Recipe : Recipes)
+			{
+				BruteForceChecksum += CanCraft(Recipe, Items);
+
+				if (!bFoundExactRecipe && Recipe->GetIngredients().OrderIndependentCompareEqual(ExactIngredients))
+				{
+					bFoundExactRecipe = true;
+				}
+			}
+
+			BruteForceChecksum += bFoundExactRecipe;
+		}
+
+		const double BruteForceTime = FPlatformTime::Seconds() - BruteForceStartTime;
+
+		UE_LOG(LogInventorySystem, Display,
+			TEXT("Inventory.Crafting.Benchmark: %d recipes, %d slots, %d definitions x %d iterations. Index: %.3f ms "
+				"(checksum %d). Brute force: %.3f ms (checksum %d)."),
+			RecipesNumber, SlotsNumber, DefinitionClasses.Num(), NumIterations, IndexedTime * 1000.0,
+			IndexedChecksum, BruteForceTime * 1000.0, BruteForceChecksum);
+	}
+};
+
+// Usage: Inventory.Crafting.Benchmark [RecipesNumber] [SlotsNumber] [NumIterations]
+static FAutoConsoleCommandWithArgs InventoryCraftingBenchmarkCommand(
+	TEXT("Inventory.Crafting.Benchmark"),
+	TEXT("Compares UInventoryCraftingSubsystem queries with a brute-force matching of all recipes."),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		const int32 RecipesNumber = Args.IsValidIndex(0) ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 1000;
+		const int32 SlotsNumber = Args.IsValidIndex(1) ? FMath::Max(FCString::Atoi(*Args[1]), 1) : 40;
+		const int32 NumIterations = Args.IsValidIndex(2) ? FMath::Max(FCString::Atoi(*Args[2]), 1) : 1000;
+
+		FInventoryCraftingBenchmark::Run(RecipesNumber, SlotsNumber, NumIterations);
+	}));
+
+#endif
@@ -0,0 +1,393 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#if !UE_BUILD_SHIPPING
+
+#include "EngineUtils.h"
+#include "InventorySystem.h"
+#include "ActorComponents/InventoryManagerComponent.h"
+#include "Actors/InventoryPickupItem.h"
+#include "Containers/Ticker.h"
+#include "Engine/NetDriver.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/Pawn.h"
+#include "Misc/FileHelper.h"
+#include "Objects/InventoryItemInstance.h"
+#include "Objects/InventoryManagerFragments/InventoryManagerDropItemsFragment.h"
+#include "Objects/InventoryManagerFragments/InventoryManagerSelectorFragment.h"
+#include "UObject/StrongObjectPtr.h"
+#include "UObject/UObjectArray.h"
+
+/**
+ * Runs every inventory operation in bulk on a real inventory and writes the cost of each operation into a CSV file, so
+ * changes to the inventory (e.g., to its fast arrays) can be compared with a baseline. Each step is executed in a
+ * single frame to measure the CPU time, memory and UObjects, and then the benchmark waits for a few frames to let the
+ * changes replicate and measures the bytes sent by the net driver. Run it on a listen server with a connected client
+ * (e.g., PIE with 2 players) to measure the replication.
+ */
+class FInventoryManagerBenchmark : public TSharedFromThis<FInventoryManagerBenchmark>
+{
+public:
+	FInventoryManagerBenchmark(UInventoryManagerComponent* InInventory, UInventoryItemInstance* InItemTemplate,
+		const FGameplayTag& InStatTag)
+		: Inventory(InInventory)
+		, ItemTemplate(InItemTemplate)
+		, StatTag(InStatTag)
+		, LayoutName(InInventory->IsFlatSlotsReplicationEnabled() ? TEXT("Flat") : TEXT("Nested"))
+	{
+		const FInventorySlotsTypedArray* MainSlots = InInventory->GetInventoryContent().GetItems().FindByKey(
+			InventorySystemGameplayTags::Inventory_Slot_Type_Main);
+
+		SlotsNumber = MainSlots ? MainSlots->Array.GetItems().Num() : 0;
+	}
+
+	void Start()
+	{
+		Steps = {
+			{ TEXT("Add"), [this] { return ExecuteAdd(); } },
+			{ TEXT("StatEdit"), [this] { return ExecuteStatEdit(); } },
+			{ TEXT("Split"), [this] { return ExecuteSplit(); } },
+			{ TEXT("Merge"), [this] { return ExecuteMerge(); } },
+			{ TEXT("Move"), [this] { return ExecuteMove(); } },
+			{ TEXT("Select"), [this] { return ExecuteSelect(); } },
+			{ TEXT("Drop"), [this] { return ExecuteDrop(); } },
+			{ TEXT("Pickup"), [this] { return ExecutePickup(); } },
+			{ TEXT("Add"), [this] { return ExecuteAdd(); } },
+			{ TEXT("Delete"), [this] { return ExecuteDelete(); } }
+		};
+
+		Csv = TEXT("Layout,Operation,Count,TotalMs,MicrosecondsPerOperation,MemoryDeltaBytes,UObjectsDelta,NetBytes,")
+			TEXT("NetBytesPerOperation\n");
+
+		// The ticker holds the only strong reference to the benchmark, so it lives until Tick returns false
+		FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda(
+			[This = AsShared()](const float DeltaTime)
+			{
+				return This->Tick(DeltaTime);
+			}));
+	}
+
+private:
+	struct FStep
+	{
+		const TCHAR* Name;
+
+		// Executes the operation as many times as possible and returns the number of executed operations
+		TFunction<int32()> Execute;
+	};
+
+	TWeakObjectPtr<UInventoryManagerComponent> Inventory;
+	TStrongObjectPtr<UInventoryItemInstance> ItemTemplate;
+	FGameplayTag StatTag;
+
+	// Run the benchmark with both values of Inventory.FlatSlotsReplication to compare the bytes per slot change
+	const TCHAR* LayoutName;
+
+	int32 SlotsNumber = 0;
+
+	TArray<FStep> Steps;
+	int32 CurrentStepIndex = 0;
+
+	// Frames to wait after each step to let the changes replicate
+	static constexpr int32 ReplicationFramesNumber = 10;
+	int32 RemainingReplicationFrames = 0;
+
+	// Results of the current step that are written when the replication frames are over
+	int32 OperationsNumber = 0;
+	double ElapsedSeconds = 0;
+	int64 MemoryDelta = 0;
+	int32 UObjectsDelta = 0;
+	uint64 StartNetBytes = 0;
+
+	FString Csv;
+
+	uint64 GetNetBytes() const
+	{
+		const UNetDriver* NetDriver = Inventory->GetWorld()->GetNetDriver();
+
+		return NetDriver ? NetDriver->OutTotalBytes : 0;
+	}
+
+	bool Tick(float DeltaTime)
+	{
+		if (!Inventory.IsValid())
+		{
+			UE_LOG(LogInventorySystem, Warning, TEXT("Inventory.Benchmark: The inventory was destroyed"));
+
+			return false;
+		}
+
+		if (RemainingReplicationFrames > 0)
+		{
+			--RemainingReplicationFrames;
+
+			if (RemainingReplicationFrames == 0)
+			{
+				FinishStep();
+			}
+
+			return true;
+		}
+
+		if (!Steps.IsValidIndex(CurrentStepIndex))
+		{
+			SaveCsv();
+
+			return false;
+		}
+
+		StartNetBytes = GetNetBytes();
+
+		const int64 StartMemory = FPlatformMemory::GetStats().UsedPhysical;
+		const int32 StartUObjectsNumber = GUObjectArray.GetObjectArrayNumMinusAvailable();
+		const double StartTime = FPlatformTime::Seconds();
+
+		OperationsNumber = Steps[CurrentStepIndex].Execute();
+
+		ElapsedSeconds = FPlatformTime::Seconds() - StartTime;
+		UObjectsDelta = GUObjectArray.GetObjectArrayNumMinusAvailable() - StartUObjectsNumber;
+		MemoryDelta = static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical) - StartMemory;
+
+		RemainingReplicationFrames = ReplicationFramesNumber;
+
+		return true;
+	}
+
+	void FinishStep()
+	{
+		const uint64 NetBytes = GetNetBytes() - StartNetBytes;
+		const int32 SafeOperationsNumber = FMath::Max(OperationsNumber, 1);
+
+		Csv += FString::Printf(TEXT("%s,%s,%d,%.4f,%.4f,%lld,%d,%llu,%.2f\n"), LayoutName,
+			Steps[CurrentStepIndex].Name, OperationsNumber, ElapsedSeconds * 1000.0,
+			ElapsedSeconds * 1000000.0 / SafeOperationsNumber, MemoryDelta, UObjectsDelta, NetBytes,
+			static_cast<double>(NetBytes) / SafeOperationsNumber);
+
+		++CurrentStepIndex;
+	}
+
+	void SaveCsv() const
+	{
+		const FString FilePath = FPaths::ProfilingDir() / TEXT("Inventory") /
+			FString::Printf(TEXT("InventoryBenchmark-%s-%s.csv"), LayoutName, *FDateTime::Now().ToString());
+
+		if (FFileHelper::SaveStringToFile(Csv, *FilePath))
+		{
+			UE_LOG(LogInventorySystem, Display, TEXT("Inventory.Benchmark: Results were saved to %s"), *FilePath);
+		}
+		else
+		{
+			UE_LOG(LogInventorySystem, Error, TEXT("Inventory.Benchmark: Failed to save the results to %s"),
+				*FilePath);
+		}
+	}
+
+	UInventoryItemInstance* GetSlotInstance(const int32 SlotIndex) const
+	{
+		return Inventory->GetItemInstance(SlotIndex);
+	}
+
+	// Fills half of the empty slots, so the other half can be used for splitting
+	int32 ExecuteAdd() const
+	{
+		int32 Count = 0;
+
+		for (int32 SlotIndex = 0; SlotIndex < SlotsNumber / 2; ++SlotIndex)
+		{
+			Count += !GetSlotInstance(SlotIndex) && Inventory->AddItem(ItemTemplate.Get(), SlotIndex);
+		}
+
+		return Count;
+	}
+
+	int32 ExecuteStatEdit() const
+	{
+		if (!StatTag.IsValid())
+		{
+			return 0;
+		}
+
+		int32 Count = 0;
+
+		for (int32 SlotIndex = 0; SlotIndex < SlotsNumber; ++SlotIndex)
+		{
+			if (Inventory->SetItemInstanceStat(SlotIndex, FInstanceStatsItem(StatTag, SlotIndex)))
+			{
+				++Count;
+			}
+		}
+
+		return Count;
+	}
+
+	// Moves one item from each stack into the second half of the slots
+	int32 ExecuteSplit() const
+	{
+		int32 Count = 0;
+
+		for (int32 SlotIndex = 0; SlotIndex < SlotsNumber / 2; ++SlotIndex)
+		{
+			const UInventoryItemInstance* ItemInstance = GetSlotInstance(SlotIndex);
+
+			if (ItemInstance && ItemInstance->GetStackCount() > 1)
+			{
+				Count += Inventory->SplitItem(SlotIndex, 1, SlotIndex + SlotsNumber / 2);
+			}
+		}
+
+		return Count;
+	}
+
+	// Moves the items that were split back into their stacks
+	int32 ExecuteMerge() const
+	{
+		int32 Count = 0;
+
+		for (int32 SlotIndex = SlotsNumber / 2; SlotIndex < SlotsNumber / 2 * 2; ++SlotIndex)
+		{
+			if (GetSlotInstance(SlotIndex))
+			{
+				Count += Inventory->MergeItems(SlotIndex, SlotIndex - SlotsNumber / 2);
+			}
+		}
+
+		return Count;
+	}
+
+	// Moves the merged stacks into the second half of the slots, so the first half is free for the next Add
+	int32 ExecuteMove() const
+	{
+		int32 Count = 0;
+
+		for (int32 SlotIndex = 0; SlotIndex < SlotsNumber / 2; ++SlotIndex)
+		{
+			if (GetSlotInstance(SlotIndex) && !GetSlotInstance(SlotIndex + SlotsNumber / 2))
+			{
+				Count += Inventory->MoveItem(SlotIndex, SlotIndex + SlotsNumber / 2);
+			}
+		}
+
+		return Count;
+	}
+
+	int32 ExecuteSelect() const
+	{
+		UInventoryManagerSelectorFragment* SelectorFragment =
+			Inventory->GetFragmentByClass<UInventoryManagerSelectorFragment>();
+
+		if (!SelectorFragment)
+		{
+			return 0;
+		}
+
+		for (int32 i = 0; i < SlotsNumber; ++i)
+		{
+			SelectorFragment->OffsetCurrentSlotIndex(1);
+		}
+
+		return SlotsNumber;
+	}
+
+	int32 ExecuteDrop() const
+	{
+		UInventoryManagerDropItemsFragment* DropItemsFragment =
+			Inventory->GetFragmentByClass<UInventoryManagerDropItemsFragment>();
+
+		if (!DropItemsFragment)
+		{
+			return 0;
+		}
+
+		int32 Count = 0;
+
+		for (int32 SlotIndex = 0; SlotIndex < SlotsNumber; ++SlotIndex)
+		{
+			if (GetSlotInstance(SlotIndex))
+			{
+				DropItemsFragment->Server_DropItem(SlotIndex, InventorySystemGameplayTags::Inventory_Slot_Type_Main);
+				++Count;
+			}
+		}
+
+		return Count;
+	}
+
+	// Picks up the items of the template's definition that are lying in the world
+	int32 ExecutePickup() const
+	{
+		int32 Count = 0;
+
+		for (TActorIterator<AInventoryPickupItem> It(Inventory->GetWorld()); It; ++It)
+		{
+			const UInventoryItemInstance* ItemInstance = It->GetItemInstance();
+
+			if (!It->IsInPool() && ItemInstance && ItemInstance->GetDefinition() == ItemTemplate->GetDefinition())
+			{
+				It->Pickup(Inventory.Get());
+				++Count;
+			}
+		}
+
+		return Count;
+	}
+
+	int32 ExecuteDelete() const
+	{
+		int32 Count = 0;
+
+		for (int32 SlotIndex = 0; SlotIndex < SlotsNumber; ++SlotIndex)
+		{
+			if (GetSlotInstance(SlotIndex))
+			{
+				Count += Inventory->DeleteItem(SlotIndex);
+			}
+		}
+
+		return Count;
+	}
+};
+
+/**
+ * Benchmarks the inventory of the first local player. Pass a stackable definition to measure the splits and merges,
+ * and a stat tag to measure the stat edits.
+ * Usage: Inventory.Benchmark <ItemDefinitionClassPath> [StatTag]
+ */
+static FAutoConsoleCommandWithWorldAndArgs InventoryBenchmarkCommand(
+	TEXT("Inventory.Benchmark"),
+	TEXT("Runs all inventory operations on the inventory of the first local player and saves the results to CSV."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (Args.IsEmpty() || World->GetNetMode() == NM_Client)
+		{
+			UE_LOG(LogInventorySystem, Warning,
+				TEXT("Inventory.Benchmark: Must be run on the server with an item definition class path"));
+
+			return;
+		}
+
+		const APlayerController* PlayerController = World->GetFirstPlayerController();
+		const APawn* Pawn = PlayerController ? PlayerController->GetPawn() : nullptr;
+
+		UInventoryManagerComponent* Inventory = Pawn ?
+			Pawn->FindComponentByClass<UInventoryManagerComponent>() : nullptr;
+
+		const TSubclassOf<UInventoryItemDefinition> DefinitionClass = StaticLoadClass(
+			UInventoryItemDefinition::StaticClass(), nullptr, *Args[0]);
+
+		if (!Inventory || !DefinitionClass)
+		{
+			UE_LOG(LogInventorySystem, Warning, TEXT("Inventory.Benchmark: Invalid inventory or item definition"));
+
+			return;
+		}
+
+		UInventoryItemInstance* ItemTemplate = NewObject<UInventoryItemInstance>(GetTransientPackage());
+		ItemTemplate->Initialize(DefinitionClass,
+			DefinitionClass->GetDefaultObject<UInventoryItemDefinition>()->GetMaxStackCount());
+
+		const FGameplayTag StatTag = Args.IsValidIndex(1) ?
+			FGameplayTag::RequestGameplayTag(*Args[1], false) : FGameplayTag::EmptyTag;
+
+		MakeShared<FInventoryManagerBenchmark>(Inventory, ItemTemplate, StatTag)->Start();
+	}));
+
+#endif
@@ -0,0 +1,98 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#if !UE_BUILD_SHIPPING
+
+#include "InventorySystem.h"
+#include "InventorySystemGameplayTags.h"
+#include "ActorComponents/InventoryManagerComponent.h"
+#include "Objects/InventoryItemInstance.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/ObjectAndNameAsStringProxyArchive.h"
+
+namespace InventorySaveDataBenchmark
+{
+	// Serializes the data the same way the save game subsystem does and returns the number of written bytes
+	int32 GetSavedBytesNumber(const TFunctionRef<void(FArchive&)> Serialize, const bool bSaveGame)
+	{
+		TArray<uint8> Bytes;
+		FMemoryWriter MemoryWriter(Bytes, true);
+
+		FObjectAndNameAsStringProxyArchive Archive(MemoryWriter, true);
+		Archive.ArIsSaveGame = bSaveGame;
+
+		Serialize(Archive);
+
+		return Bytes.Num();
+	}
+}
+
+/**
+ * Compares the size of the compact inventory save record with the size of full serialized item instances and measures
+ * how long it takes to rebuild the items from the record.
+ * Usage: Inventory.SaveData.Benchmark <DefinitionClassPath> [ItemsNumber]
+ */
+static FAutoConsoleCommandWithArgs InventorySaveDataBenchmarkCommand(
+	TEXT("Inventory.SaveData.Benchmark"),
+	TEXT("Measures the size of the compact inventory save record and the time to load the items from it."),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		const TSubclassOf<UInventoryItemDefinition> DefinitionClass = Args.IsEmpty() ?
+			nullptr : StaticLoadClass(UInventoryItemDefinition::StaticClass(), nullptr, *Args[0]);
+
+		if (!DefinitionClass)
+		{
+			UE_LOG(LogInventorySystem, Warning,
+				TEXT("Inventory.SaveData.Benchmark: Must be run with a valid item definition class path"));
+
+			return;
+		}
+
+		const int32 ItemsNumber = Args.IsValidIndex(1) ? FMath::Max(FCString::Atoi(*Args[1]), 1) : 1000;
+
+		UInventoryItemInstance* ItemInstance = NewObject<UInventoryItemInstance>(GetTransientPackage());
+		ItemInstance->Initialize(DefinitionClass);
+
+		// === Build the record as SaveContent would do for a full inventory of identical items ===
+
+		FInventorySaveData SaveData;
+		SaveData.Definitions.Add(DefinitionClass.Get());
+		SaveData.SlotTypeTags.Add(InventorySystemGameplayTags::Inventory_Slot_Type_Main);
+
+		for (int32 i = 0; i < ItemsNumber; ++i)
+		{
+			FInventorySlotSaveData& SlotSaveData = SaveData.Slots.AddDefaulted_GetRef();
+			SlotSaveData.SlotIndex = i;
+		}
+
+		const int32 CompactBytesNumber = InventorySaveDataBenchmark::GetSavedBytesNumber(
+			[&SaveData](FArchive& Archive)
+			{
+				FInventorySaveData::StaticStruct()->SerializeItem(Archive, &SaveData, nullptr);
+			},
+			true);
+
+		// Each item instance serialized with all of its properties (definition path, stats, etc.)
+		const int32 FullItemBytesNumber = InventorySaveDataBenchmark::GetSavedBytesNumber(
+			[ItemInstance](FArchive& Archive)
+			{
+				ItemInstance->Serialize(Archive);
+			},
+			false);
+
+		// === Measure the bulk load ===
+
+		TArray<UInventoryItemInstance*> ItemInstances;
+
+		const double LoadStartTime = FPlatformTime::Seconds();
+		UInventoryManagerComponent::CreateItemInstances(SaveData, GetTransientPackage(), ItemInstances);
+		const double LoadTime = FPlatformTime::Seconds() - LoadStartTime;
+
+		UE_LOG(LogInventorySystem, Display,
+			TEXT("Inventory.SaveData.Benchmark: %d items of %s. Compact record: %d bytes (%.2f bytes per item). "
+				"Full item instances: %d bytes (%d bytes per item). Load: %.3f ms (%.3f us per item)."),
+			ItemsNumber, *DefinitionClass->GetName(), CompactBytesNumber,
+			static_cast<float>(CompactBytesNumber) / ItemsNumber, FullItemBytesNumber * ItemsNumber,
+			FullItemBytesNumber, LoadTime * 1000.0, LoadTime * 1000000.0 / ItemsNumber);
+	}));
+
+#endif
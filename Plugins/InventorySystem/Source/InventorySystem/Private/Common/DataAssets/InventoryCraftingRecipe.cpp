@@ -0,0 +1,13 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Common/DataAssets/InventoryCraftingRecipe.h"
+
+#include "Objects/InventoryItemDefinition.h"
+
+void UInventoryCraftingRecipe::Initialize(const TMap<TSubclassOf<UInventoryItemDefinition>, int32>& InIngredients,
+	const TSubclassOf<UInventoryItemDefinition>& InResultDefinition, const int32 InResultCount)
+{
+	Ingredients = InIngredients;
+	ResultDefinition = InResultDefinition;
+	ResultCount = FMath::Max(InResultCount, 1);
+}
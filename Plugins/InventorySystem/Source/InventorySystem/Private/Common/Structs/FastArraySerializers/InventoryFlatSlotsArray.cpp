@@ -0,0 +1,32 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Common/Structs/FastArraySerializers/InventoryFlatSlotsArray.h"
+
+#include "ActorComponents/InventoryManagerComponent.h"
+
+void FInventoryFlatSlot::PostReplicatedAdd(const FInventoryFlatSlotsArray& InArraySerializer)
+{
+	ApplyToInventory(InArraySerializer);
+}
+
+void FInventoryFlatSlot::PostReplicatedChange(const FInventoryFlatSlotsArray& InArraySerializer)
+{
+	ApplyToInventory(InArraySerializer);
+}
+
+void FInventoryFlatSlot::ApplyToInventory(const FInventoryFlatSlotsArray& InArraySerializer) const
+{
+	UInventoryManagerComponent* Inventory = InArraySerializer.GetOwner();
+
+	if (!ensureAlways(IsValid(Inventory)))
+	{
+		return;
+	}
+
+	UInventoryItemInstance* OldInstance = Inventory->SetReplicatedSlotInstance(Instance, TypeTag, SlotIndex);
+
+	if (OldInstance != Instance)
+	{
+		Inventory->OnContentChanged.Broadcast(FInventoryContentChange(TypeTag, SlotIndex, OldInstance, Instance));
+	}
+}
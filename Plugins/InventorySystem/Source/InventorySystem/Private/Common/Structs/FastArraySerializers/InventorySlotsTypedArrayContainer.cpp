@@ -0,0 +1,65 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Common/Structs/FastArraySerializers/InventorySlotsTypedArrayContainer.h"
+
+#include "ActorComponents/InventoryManagerComponent.h"
+
+void FInventorySlotsTypedArray::PostReplicatedAdd(const FInventorySlotsTypedArrayContainer& InArraySerializer)
+{
+	BroadcastReplicatedChanges(InArraySerializer);
+}
+
+void FInventorySlotsTypedArray::PostReplicatedChange(const FInventorySlotsTypedArrayContainer& InArraySerializer)
+{
+	BroadcastReplicatedChanges(InArraySerializer);
+}
+
+void FInventorySlotsTypedArray::BroadcastReplicatedChanges(const FInventorySlotsTypedArrayContainer& InArraySerializer)
+{
+	UInventoryManagerComponent* Inventory = InArraySerializer.GetOwner();
+
+	if (!ensureAlways(IsValid(Inventory)))
+	{
+		return;
+	}
+
+	const TArray<FInventorySlot>& Slots = Array.GetItems();
+
+	ReplicatedSlots.SetNum(Slots.Num());
+
+	for (int32 SlotIndex = 0; SlotIndex < Slots.Num(); ++SlotIndex)
+	{
+		FReplicatedSlot& ReplicatedSlot = ReplicatedSlots[SlotIndex];
+		UInventoryItemInstance* NewInstance = Slots[SlotIndex].Instance;
+		const bool bOccupied = NewInstance != nullptr;
+
+		// The weak pointer is compared by the serial number, so a new object at the address of a freed one differs
+		if (ReplicatedSlot.bOccupied == bOccupied && ReplicatedSlot.Instance == NewInstance)
+		{
+			continue;
+		}
+
+		EInventoryContentChangeType ChangeType;
+
+		if (!ReplicatedSlot.bOccupied)
+		{
+			ChangeType = EInventoryContentChangeType::Added;
+		}
+		else if (!bOccupied)
+		{
+			ChangeType = EInventoryContentChangeType::Removed;
+		}
+		else
+		{
+			ChangeType = EInventoryContentChangeType::Replaced;
+		}
+
+		UInventoryItemInstance* OldInstance = ReplicatedSlot.Instance.Get();
+
+		ReplicatedSlot.Instance = NewInstance;
+		ReplicatedSlot.bOccupied = bOccupied;
+
+		Inventory->OnContentChanged.Broadcast(FInventoryContentChange(TypeTag, SlotIndex, OldInstance, NewInstance,
+			ChangeType));
+	}
+}
@@ -7,4 +7,8 @@ namespace InventorySystemGameplayTags
 	// SlotTypes
 	UE_DEFINE_GAMEPLAY_TAG_COMMENT(Inventory_Slot_Type_Main, "Inventory.Slot.Type.Main",
 		"Main slot type. This type must be contained in any UInventoryManagerComponent!");
+
+	// InstanceStats
+	UE_DEFINE_GAMEPLAY_TAG_COMMENT(Inventory_Item_Stat_StackCount, "Inventory.Item.Stat.StackCount",
+		"Number of items stored in a single stackable item instance.");
 }
\ No newline at end of file
@@ -0,0 +1,40 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Objects/InventoryItemDefinition.h"
+
+#include "Objects/InventoryItemInstance.h"
+#include "Objects/InventoryItemFragments/StackableInventoryItemFragment.h"
+
+const TArray<FInstanceStatsItem>& UInventoryItemDefinition::GetDefaultInstanceStats() const
+{
+#if DO_CHECK
+	check(HasAnyFlags(RF_ClassDefaultObject));
+#endif
+
+	if (!bDefaultInstanceStatsGathered)
+	{
+		// The stats are set by the fragments when the item is initialized, so the only way to get them is to create one
+		UInventoryItemInstance* ItemInstance = NewObject<UInventoryItemInstance>(GetTransientPackage());
+		ItemInstance->Initialize(GetClass());
+
+		DefaultInstanceStats = ItemInstance->GetInstanceStats().GetAllStats();
+		bDefaultInstanceStatsGathered = true;
+	}
+
+	return DefaultInstanceStats;
+}
+
+int32 UInventoryItemDefinition::GetMaxStackCount() const
+{
+	for (const UInventoryItemFragment* Fragment : Fragments)
+	{
+		const UStackableInventoryItemFragment* StackableFragment = Cast<UStackableInventoryItemFragment>(Fragment);
+
+		if (IsValid(StackableFragment))
+		{
+			return StackableFragment->GetMaxStackCount();
+		}
+	}
+
+	return 1;
+}
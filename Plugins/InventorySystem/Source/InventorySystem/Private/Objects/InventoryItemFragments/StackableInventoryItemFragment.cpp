@@ -0,0 +1,17 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Objects/InventoryItemFragments/StackableInventoryItemFragment.h"
+
+#include "InventorySystemGameplayTags.h"
+#include "Objects/InventoryItemInstance.h"
+
+void UStackableInventoryItemFragment::OnItemInstanceInitialized(UInventoryItemInstance* Instance)
+{
+	Super::OnItemInstanceInitialized(Instance);
+
+	// Duplicated instances already have their stack count copied, so we only set it for the brand-new ones
+	if (!Instance->GetInstanceStats().HasStat(InventorySystemGameplayTags::Inventory_Item_Stat_StackCount))
+	{
+		Instance->SetStackCount(1);
+	}
+}
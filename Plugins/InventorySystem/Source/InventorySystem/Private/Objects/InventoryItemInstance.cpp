@@ -2,16 +2,23 @@
 
 #include "Objects/InventoryItemInstance.h"
 
+#include "InventorySystemGameplayTags.h"
 #include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
 #include "Objects/InventoryItemDefinition.h"
 #include "Objects/InventoryItemFragment.h"
+#include "Objects/InventoryItemFragments/StackableInventoryItemFragment.h"
 
 void UInventoryItemInstance::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
 {
 	UObject::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-	DOREPLIFETIME(ThisClass, Definition);
-	DOREPLIFETIME(ThisClass, InstanceStats);
+	// Item instances rarely change after they are created, so they are only compared when they are marked dirty
+	FDoRepLifetimeParams Params;
+	Params.bIsPushBased = true;
+
+	DOREPLIFETIME_WITH_PARAMS_FAST(ThisClass, Definition, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(ThisClass, InstanceStats, Params);
 }
 
 void UInventoryItemInstance::Initialize(const TSubclassOf<UInventoryItemDefinition>& InDefinition)
@@ -23,6 +30,7 @@ void UInventoryItemInstance::Initialize(const TSubclassOf<UInventoryItemDefiniti
 	if (IsValid(InDefinition))
 	{
 		Definition = InDefinition;
+		MARK_PROPERTY_DIRTY_FROM_NAME(ThisClass, Definition, this);
 	}
 
 #if DO_CHECK
@@ -41,6 +49,24 @@ void UInventoryItemInstance::Initialize(const TSubclassOf<UInventoryItemDefiniti
 	bInitialized = true;
 }
 
+void UInventoryItemInstance::Initialize(const TSubclassOf<UInventoryItemDefinition>& InDefinition,
+	const int32 InStackCount)
+{
+	Initialize(InDefinition);
+
+	// Items without UStackableInventoryItemFragment always store a single item
+	if (IsStackable())
+	{
+		SetStackCount(InStackCount);
+
+		return;
+	}
+
+#if DO_ENSURE
+	ensureAlwaysMsgf(InStackCount == 1, TEXT("Item %s isn't stackable!"), *GetName());
+#endif
+}
+
 UInventoryItemInstance* UInventoryItemInstance::Duplicate(UObject* Outer) const
 {
 	if (!IsValid(Outer))
@@ -57,10 +83,89 @@ UInventoryItemInstance* UInventoryItemInstance::Duplicate(UObject* Outer) const
 	// Copy FInstanceStats
 	for (const FInstanceStatsItem& Item : InstanceStats.GetAllStats())
 	{
-		NewItemInstance->InstanceStats.SetStat(Item);
+		NewItemInstance->SetInstanceStat(Item);
 	}
 
 	NewItemInstance->Initialize(GetDefinition());
 
 	return NewItemInstance;
 }
+
+int32 UInventoryItemInstance::GetStackCount() const
+{
+	const FInstanceStatsItem* StackCountStat =
+		InstanceStats.GetStat(InventorySystemGameplayTags::Inventory_Item_Stat_StackCount);
+
+	return StackCountStat ? FMath::RoundToInt32(StackCountStat->Value) : 1;
+}
+
+void UInventoryItemInstance::SetStackCount(const int32 NewStackCount)
+{
+#if DO_ENSURE
+	ensureAlwaysMsgf(NewStackCount > 0 && NewStackCount <= GetMaxStackCount(),
+		TEXT("Stack count %d is out of range for item %s!"), NewStackCount, *GetName());
+#endif
+
+	SetInstanceStat(FInstanceStatsItem(InventorySystemGameplayTags::Inventory_Item_Stat_StackCount, NewStackCount));
+}
+
+void UInventoryItemInstance::SetInstanceStat(const FInstanceStatsItem& InStat)
+{
+	InstanceStats.SetStat(InStat);
+	MARK_PROPERTY_DIRTY_FROM_NAME(ThisClass, InstanceStats, this);
+}
+
+void UInventoryItemInstance::RemoveInstanceStat(const FGameplayTag& InTag)
+{
+	InstanceStats.RemoveStat(InTag);
+	MARK_PROPERTY_DIRTY_FROM_NAME(ThisClass, InstanceStats, this);
+}
+
+int32 UInventoryItemInstance::GetMaxStackCount() const
+{
+	const UStackableInventoryItemFragment* StackableFragment = GetFragmentByClass<UStackableInventoryItemFragment>();
+
+	return StackableFragment ? StackableFragment->GetMaxStackCount() : 1;
+}
+
+bool UInventoryItemInstance::CanStackWith(const UInventoryItemInstance* Other) const
+{
+	if (!IsValid(Other) || Other == this)
+	{
+		return false;
+	}
+
+	return CanStackWith(Other->GetDefinition(), Other->GetInstanceStats().GetAllStats());
+}
+
+bool UInventoryItemInstance::CanStackWith(const TSubclassOf<UInventoryItemDefinition>& OtherDefinition,
+	const TArray<FInstanceStatsItem>& OtherStats) const
+{
+	if (OtherDefinition != Definition || !IsStackable())
+	{
+		return false;
+	}
+
+	if (OtherStats.Num() != InstanceStats.GetAllStats().Num())
+	{
+		return false;
+	}
+
+	// The items are considered equal if all of their stats except for the stack count are equal
+	for (const FInstanceStatsItem& OtherStat : OtherStats)
+	{
+		if (OtherStat.Tag == InventorySystemGameplayTags::Inventory_Item_Stat_StackCount)
+		{
+			continue;
+		}
+
+		const FInstanceStatsItem* Stat = InstanceStats.GetStat(OtherStat.Tag);
+
+		if (!Stat || Stat->Value != OtherStat.Value)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
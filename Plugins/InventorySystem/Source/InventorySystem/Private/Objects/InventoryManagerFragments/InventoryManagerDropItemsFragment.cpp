@@ -3,6 +3,7 @@
 #include "Objects/InventoryManagerFragments/InventoryManagerDropItemsFragment.h"
 
 #include "Actors/InventoryPickupItem.h"
+#include "Subsystems/InventoryPickupItemPoolSubsystem.h"
 
 void UInventoryManagerDropItemsFragment::Server_DropItem_Implementation(const int32 SlotIndex,
 	const FGameplayTag& SlotsType)
@@ -23,28 +24,28 @@ void UInventoryManagerDropItemsFragment::Server_DropItem_Implementation(const in
 		return;
 	}
 
-	// Spawn an item into the world to make it able to pick up later
-	AInventoryPickupItem* ItemActor = GetWorld()->SpawnActorDeferred<AInventoryPickupItem>(DropItemActorClass,
-		Inventory->GetOwner()->GetActorTransform());
+	UInventoryPickupItemPoolSubsystem* PickupItemPoolSubsystem =
+		GetWorld()->GetSubsystem<UInventoryPickupItemPoolSubsystem>();
 
-	if (!ensureAlways(IsValid(ItemActor)))
+	if (!ensureAlways(IsValid(PickupItemPoolSubsystem)))
 	{
 		return;
 	}
 
-	ItemActor->SetItemInstance(ItemInstance->Duplicate(ItemActor));
+	const FTransform OwnerActorTransform = Inventory->GetOwner()->GetActorTransform();
+
+	// Take an item actor from the pool (or spawn a new one) to make it able to pick up later
+	AInventoryPickupItem* ItemActor = PickupItemPoolSubsystem->AcquirePickupItem(DropItemActorClass, ItemInstance,
+		OwnerActorTransform);
 
-#if DO_CHECK
-	check(IsValid(ItemActor->GetItemInstance()));
-#endif
+	if (!ensureAlways(IsValid(ItemActor)))
+	{
+		return;
+	}
 
 	// Remove an item from the slot because we dropped it
 	ensureAlways(Inventory->DeleteItem(SlotIndex, SlotsType));
 
-	const FTransform OwnerActorTransform = Inventory->GetOwner()->GetActorTransform();
-
-	ItemActor->FinishSpawning(OwnerActorTransform);
-
 	// === Add a throw impulse ===
 
 	UPrimitiveComponent* ItemActorMeshComponent = ItemActor->GetMesh();
@@ -3,9 +3,12 @@
 #include "Objects/InventoryManagerFragments/InventoryManagerSelectorFragment.h"
 
 #include "InventorySystem.h"
+#include "TimerManager.h"
 #include "ActorComponents/InventoryManagerComponent.h"
 #include "Net/UnrealNetwork.h"
 
+DECLARE_DWORD_COUNTER_STAT(TEXT("Selection RPCs"), STAT_InventorySelectionRPCs, STATGROUP_Inventory);
+
 void UInventoryManagerSelectorFragment::OnManagerInitialized()
 {
 	Super::OnManagerInitialized();
@@ -16,7 +19,7 @@ void UInventoryManagerSelectorFragment::OnManagerInitialized()
 		OnOffsetCurrentSlotIndex.AddLambda([this](int32 Index)
 		{
 			LogCurrentSlotIndex();
-		});	
+		});
 	}
 #endif
 }
@@ -26,16 +29,17 @@ void UInventoryManagerSelectorFragment::GetLifetimeReplicatedProps(
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-	DOREPLIFETIME(ThisClass, CurrentSlotIndex);
+	DOREPLIFETIME_CONDITION(ThisClass, CurrentSlotIndex, COND_SkipOwner);
+	DOREPLIFETIME_CONDITION(ThisClass, AcceptedSelection, COND_OwnerOnly);
 }
 
-void UInventoryManagerSelectorFragment::Server_OffsetCurrentSlotIndex_Implementation(const int32 Offset)
+int32 UInventoryManagerSelectorFragment::GetSlotsNumber() const
 {
-	UInventoryManagerComponent* Inventory = GetInventoryManager();
+	const UInventoryManagerComponent* Inventory = GetInventoryManager();
 
 	if (!ensureAlways(IsValid(Inventory)))
 	{
-		return;
+		return 0;
 	}
 
 	const FInventorySlotsTypedArray* SlotsTypedArray =
@@ -43,33 +47,136 @@ void UInventoryManagerSelectorFragment::Server_OffsetCurrentSlotIndex_Implementa
 
 	if (!ensureAlways(SlotsTypedArray))
 	{
-		return;
+		return 0;
 	}
 
-	const int32 SlotsNumber = SlotsTypedArray->Array.GetItems().Num();
+	return SlotsTypedArray->Array.GetItems().Num();
+}
+
+void UInventoryManagerSelectorFragment::OffsetCurrentSlotIndex(const int32 Offset)
+{
+	const int32 SlotsNumber = GetSlotsNumber();
+
+	if (SlotsNumber == 0)
+	{
+		return;
+	}
 
 	// Offset the index taking into account the array size
-	CurrentSlotIndex = ((CurrentSlotIndex + Offset) % SlotsNumber + SlotsNumber) % SlotsNumber;
+	SetCurrentSlotIndex(((CurrentSlotIndex + Offset) % SlotsNumber + SlotsNumber) % SlotsNumber);
 
-#if DO_ENSURE
-	ensureAlways(SlotsTypedArray->Array.IsValidSlotIndex(CurrentSlotIndex));
-#endif
+	// The owning client predicts the change and lets the server know about it later
+	if (!GetInventoryManager()->GetOwner()->HasAuthority())
+	{
+		++PredictedSequence;
 
-#if WITH_EDITORONLY_DATA && !NO_LOGGING
-	if (bLogCurrentSlotIndex)
+		ScheduleSend();
+
+		return;
+	}
+
+	/**
+	 * The owner doesn't receive CurrentSlotIndex, so the change is sent to it as an accepted selection. The new
+	 * sequence number also makes the server ignore the client changes that were predicted before this one arrived.
+	 */
+	AcceptedSelection.SlotIndex = CurrentSlotIndex;
+	++AcceptedSelection.Sequence;
+	AcceptedSelection.bServerOriginated = true;
+}
+
+void UInventoryManagerSelectorFragment::SetCurrentSlotIndex(const int32 NewSlotIndex)
+{
+	if (CurrentSlotIndex == NewSlotIndex)
 	{
-		LogCurrentSlotIndex();
+		return;
 	}
-#endif
+
+	CurrentSlotIndex = NewSlotIndex;
 
 	OnOffsetCurrentSlotIndex.Broadcast(CurrentSlotIndex);
 }
 
+void UInventoryManagerSelectorFragment::ScheduleSend()
+{
+	FTimerManager& TimerManager = GetInventoryManager()->GetWorld()->GetTimerManager();
+
+	// Don't wait for the resend if the new change was made after the previous one was sent
+	if (TimerManager.IsTimerActive(SendTimerHandle) && TimerManager.GetTimerRemaining(SendTimerHandle) <= SendDelay)
+	{
+		return;
+	}
+
+	if (SendDelay > 0)
+	{
+		TimerManager.SetTimer(SendTimerHandle, this, &ThisClass::SendPredictedSelection, SendDelay);
+	}
+	else
+	{
+		SendPredictedSelection();
+	}
+}
+
+void UInventoryManagerSelectorFragment::SendPredictedSelection()
+{
+	if (AcceptedSelection.Sequence == PredictedSequence)
+	{
+		return;
+	}
+
+	INC_DWORD_STAT(STAT_InventorySelectionRPCs);
+
+	Server_SetCurrentSlotIndex(CurrentSlotIndex, PredictedSequence);
+
+	// The RPC is unreliable, so send it again if it's lost
+	GetInventoryManager()->GetWorld()->GetTimerManager().SetTimer(SendTimerHandle, this,
+		&ThisClass::SendPredictedSelection, ResendInterval);
+}
+
+void UInventoryManagerSelectorFragment::Server_SetCurrentSlotIndex_Implementation(const int32 SlotIndex,
+	const uint16 Sequence)
+{
+	// Ignore the updates that arrived out of order or were resent after being accepted (wraps around the uint16)
+	if (static_cast<int16>(Sequence - AcceptedSelection.Sequence) <= 0)
+	{
+		return;
+	}
+
+	// Keep the current selection if the client sent an invalid index, so the client gets corrected
+	if (SlotIndex >= 0 && SlotIndex < GetSlotsNumber())
+	{
+		SetCurrentSlotIndex(SlotIndex);
+	}
+
+	AcceptedSelection.SlotIndex = CurrentSlotIndex;
+	AcceptedSelection.Sequence = Sequence;
+	AcceptedSelection.bServerOriginated = false;
+}
+
 void UInventoryManagerSelectorFragment::OnRep_SelectedSlotIndex()
 {
 	OnOffsetCurrentSlotIndex.Broadcast(CurrentSlotIndex);
 }
 
+void UInventoryManagerSelectorFragment::OnRep_AcceptedSelection()
+{
+	// The server overrides the prediction, and the next predicted changes continue from its sequence number
+	if (AcceptedSelection.bServerOriginated)
+	{
+		PredictedSequence = AcceptedSelection.Sequence;
+	}
+
+	// There are newer predicted changes the server doesn't know about yet, so this response is already outdated
+	if (AcceptedSelection.Sequence != PredictedSequence)
+	{
+		return;
+	}
+
+	GetInventoryManager()->GetWorld()->GetTimerManager().ClearTimer(SendTimerHandle);
+
+	// Correct the prediction only if the server disagrees with it
+	SetCurrentSlotIndex(AcceptedSelection.SlotIndex);
+}
+
 #if WITH_EDITORONLY_DATA && !NO_LOGGING
 void UInventoryManagerSelectorFragment::LogCurrentSlotIndex() const
 {
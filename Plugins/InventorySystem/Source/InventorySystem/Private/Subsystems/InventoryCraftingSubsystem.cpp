@@ -0,0 +1,271 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Subsystems/InventoryCraftingSubsystem.h"
+
+#include "ActorComponents/InventoryManagerComponent.h"
+#include "Common/DataAssets/InventoryCraftingRecipe.h"
+#include "Objects/InventoryItemDefinition.h"
+#include "Objects/InventoryItemInstance.h"
+
+void UInventoryCraftingSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	for (const TSoftObjectPtr<UInventoryCraftingRecipe>& Recipe : DefaultRecipes)
+	{
+		RegisterRecipe(Recipe.LoadSynchronous());
+	}
+}
+
+uint32 UInventoryCraftingSubsystem::GetIngredientsHash(const TMap<TSubclassOf<UInventoryItemDefinition>, int32>& Items)
+{
+	/**
+	 * Each pair is hashed separately and the results are summed up, so the hash is the same for any order of the items.
+	 * The pair hashes are mixed well enough for the sum not to collide on similar multisets, and the collisions that
+	 * still happen are resolved by comparing the ingredients.
+	 */
+	uint32 Hash = 0;
+
+	for (const TPair<TSubclassOf<UInventoryItemDefinition>, int32>& Pair : Items)
+	{
+		Hash += MurmurFinalize32(HashCombineFast(GetTypeHash(Pair.Key), GetTypeHash(Pair.Value)));
+	}
+
+	return Hash;
+}
+
+void UInventoryCraftingSubsystem::RegisterRecipe(const UInventoryCraftingRecipe* Recipe)
+{
+	if (!ensureAlways(IsValid(Recipe)) || !ensureAlways(IsValid(Recipe->GetResultDefinition())) ||
+		!ensureAlways(!Recipe->GetIngredients().IsEmpty()))
+	{
+		return;
+	}
+
+	const int32 RecipeIndex = IndexedRecipes.Add(Recipe);
+
+	RecipeIndicesByHash.Add(GetIngredientsHash(Recipe->GetIngredients()), RecipeIndex);
+
+	for (const TPair<TSubclassOf<UInventoryItemDefinition>, int32>& Ingredient : Recipe->GetIngredients())
+	{
+		UsagesByIngredient.FindOrAdd(Ingredient.Key).Add({ RecipeIndex, Ingredient.Value });
+	}
+}
+
+void UInventoryCraftingSubsystem::ResetRecipes()
+{
+	IndexedRecipes.Empty();
+	RecipeIndicesByHash.Empty();
+	UsagesByIngredient.Empty();
+}
+
+const UInventoryCraftingRecipe* UInventoryCraftingSubsystem::FindRecipeByIngredients(
+	const TMap<TSubclassOf<UInventoryItemDefinition>, int32>& Items) const
+{
+	for (auto It = RecipeIndicesByHash.CreateConstKeyIterator(GetIngredientsHash(Items)); It; ++It)
+	{
+		const UInventoryCraftingRecipe* Recipe = IndexedRecipes[It.Value()];
+
+		// Resolve the hash collisions
+		if (Recipe->GetIngredients().OrderIndependentCompareEqual(Items))
+		{
+			return Recipe;
+		}
+	}
+
+	return nullptr;
+}
+
+void UInventoryCraftingSubsystem::GetCraftableRecipes(const TMap<TSubclassOf<UInventoryItemDefinition>, int32>& Items,
+	TArray<const UInventoryCraftingRecipe*>& OutRecipes) const
+{
+	OutRecipes.Empty();
+
+	// Number of ingredients of each visited recipe that are available in the required numbers
+	TMap<int32, int32> SatisfiedIngredientsNumbers;
+
+	for (const TPair<TSubclassOf<UInventoryItemDefinition>, int32>& Item : Items)
+	{
+		const TArray<FIngredientUsage>* Usages = UsagesByIngredient.Find(Item.Key);
+
+		if (!Usages)
+		{
+			continue;
+		}
+
+		for (const FIngredientUsage& Usage : *Usages)
+		{
+			if (Item.Value < Usage.Count)
+			{
+				continue;
+			}
+
+			const int32 SatisfiedIngredientsNumber = ++SatisfiedIngredientsNumbers.FindOrAdd(Usage.RecipeIndex);
+			const UInventoryCraftingRecipe* Recipe = IndexedRecipes[Usage.RecipeIndex];
+
+			// Each ingredient is visited only once per recipe, so the recipe is added only once
+			if (SatisfiedIngredientsNumber == Recipe->GetIngredients().Num())
+			{
+				OutRecipes.Add(Recipe);
+			}
+		}
+	}
+}
+
+void UInventoryCraftingSubsystem::GetCraftableRecipes(const UInventoryManagerComponent* Inventory,
+	TArray<const UInventoryCraftingRecipe*>& OutRecipes) const
+{
+#if DO_CHECK
+	check(IsValid(Inventory));
+#endif
+
+	TMap<TSubclassOf<UInventoryItemDefinition>, int32> Items;
+	Inventory->GatherItemsCount(Items);
+
+	GetCraftableRecipes(Items, OutRecipes);
+}
+
+bool UInventoryCraftingSubsystem::Craft(UInventoryManagerComponent* Inventory,
+	const UInventoryCraftingRecipe* Recipe) const
+{
+#if DO_CHECK
+	check(IsValid(Inventory));
+	check(IsValid(Recipe));
+#endif
+
+#if DO_ENSURE
+	ensureAlways(Inventory->GetOwner()->HasAuthority());
+#endif
+
+	TMap<TSubclassOf<UInventoryItemDefinition>, int32> Items;
+	Inventory->GatherItemsCount(Items);
+
+	for (const TPair<TSubclassOf<UInventoryItemDefinition>, int32>& Ingredient : Recipe->GetIngredients())
+	{
+		if (Items.FindRef(Ingredient.Key) < Ingredient.Value)
+		{
+			return false;
+		}
+	}
+
+	TArray<FConsumedSlot> Plan;
+
+	for (const TPair<TSubclassOf<UInventoryItemDefinition>, int32>& Ingredient : Recipe->GetIngredients())
+	{
+		if (!ensureAlways(PlanConsumption(Inventory, Ingredient.Key, Ingredient.Value, Plan)))
+		{
+			return false;
+		}
+	}
+
+	const int32 ResultCount = FMath::Max(Recipe->GetResultCount(), 1);
+
+	// Check the space before consuming anything, so nothing has to be given back if the result doesn't fit
+	if (GetFreeSpaceAfterConsumption(Inventory, Recipe->GetResultDefinition(), Plan) < ResultCount)
+	{
+		return false;
+	}
+
+	for (const FConsumedSlot& ConsumedSlot : Plan)
+	{
+		ensureAlways(Inventory->ConsumeItem(ConsumedSlot.SlotIndex, ConsumedSlot.Count, ConsumedSlot.TypeTag));
+	}
+
+	const int32 MaxStackCount =
+		Recipe->GetResultDefinition()->GetDefaultObject<UInventoryItemDefinition>()->GetMaxStackCount();
+
+	/**
+	 * Results that don't fit into a single stack are split into several stacks. They are created only when the craft is
+	 * known to succeed, so failed crafts don't allocate anything.
+	 */
+	for (int32 RemainingCount = ResultCount; RemainingCount > 0;)
+	{
+		const int32 PortionCount = FMath::Min(RemainingCount, MaxStackCount);
+
+		UInventoryItemInstance* ResultItemInstance = NewObject<UInventoryItemInstance>(Inventory);
+		ResultItemInstance->Initialize(Recipe->GetResultDefinition(), PortionCount);
+
+		ensureAlways(Inventory->AddItemInstance(ResultItemInstance));
+
+		RemainingCount -= PortionCount;
+	}
+
+	return true;
+}
+
+bool UInventoryCraftingSubsystem::PlanConsumption(const UInventoryManagerComponent* Inventory,
+	const TSubclassOf<UInventoryItemDefinition>& Definition, int32 Count, TArray<FConsumedSlot>& OutPlan)
+{
+	for (const FInventorySlotsTypedArray& TypedArray : Inventory->GetInventoryContent().GetItems())
+	{
+		const TArray<FInventorySlot>& Slots = TypedArray.Array.GetItems();
+
+		for (int32 SlotIndex = 0; SlotIndex < Slots.Num() && Count > 0; ++SlotIndex)
+		{
+			const UInventoryItemInstance* ItemInstance = Slots[SlotIndex].Instance;
+
+			if (!IsValid(ItemInstance) || ItemInstance->GetDefinition() != Definition)
+			{
+				continue;
+			}
+
+			const int32 ConsumedCount = FMath::Min(ItemInstance->GetStackCount(), Count);
+
+			OutPlan.Add({ TypedArray.TypeTag, SlotIndex, ConsumedCount });
+			Count -= ConsumedCount;
+		}
+
+		if (Count <= 0)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+int32 UInventoryCraftingSubsystem::GetFreeSpaceAfterConsumption(const UInventoryManagerComponent* Inventory,
+	const TSubclassOf<UInventoryItemDefinition>& Definition, const TArray<FConsumedSlot>& Plan)
+{
+	// The result is added by the automatic search of AddItemInstance, which uses the main slots
+	const FGameplayTag& SlotTypeTag = InventorySystemGameplayTags::Inventory_Slot_Type_Main;
+	const int32 ArrayIndex = Inventory->GetInventoryContent().IndexOfByTag(SlotTypeTag);
+
+	if (ArrayIndex == INDEX_NONE)
+	{
+		return 0;
+	}
+
+	const TArray<FInventorySlot>& Slots = Inventory->GetInventoryContent()[ArrayIndex].Array.GetItems();
+	const UInventoryItemDefinition* DefinitionDefaultObject = Definition->GetDefaultObject<UInventoryItemDefinition>();
+	const TArray<FInstanceStatsItem>& DefaultStats = DefinitionDefaultObject->GetDefaultInstanceStats();
+	const int32 MaxStackCount = DefinitionDefaultObject->GetMaxStackCount();
+
+	int32 FreeSpace = 0;
+
+	for (int32 SlotIndex = 0; SlotIndex < Slots.Num(); ++SlotIndex)
+	{
+		const UInventoryItemInstance* SlotInstance = Slots[SlotIndex].Instance;
+
+		int32 StackCount = IsValid(SlotInstance) ? SlotInstance->GetStackCount() : 0;
+
+		for (const FConsumedSlot& ConsumedSlot : Plan)
+		{
+			if (ConsumedSlot.SlotIndex == SlotIndex && ConsumedSlot.TypeTag == SlotTypeTag)
+			{
+				StackCount -= ConsumedSlot.Count;
+			}
+		}
+
+		if (StackCount <= 0)
+		{
+			FreeSpace += MaxStackCount;
+		}
+		else if (SlotInstance->CanStackWith(Definition, DefaultStats))
+		{
+			FreeSpace += FMath::Max(MaxStackCount - StackCount, 0);
+		}
+	}
+
+	return FreeSpace;
+}
@@ -0,0 +1,259 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Subsystems/InventoryItemIndexSubsystem.h"
+
+#include "EngineUtils.h"
+#include "InventorySystem.h"
+#include "ActorComponents/InventoryManagerComponent.h"
+#include "Actors/InventoryPickupItem.h"
+#include "Objects/InventoryItemDefinition.h"
+
+void UInventoryItemIndexSubsystem::FItemsCounter::Add(const TObjectKey<UObject>& HolderKey, const int32 Count)
+{
+	TotalCount += Count;
+	CountByHolder.FindOrAdd(HolderKey) += Count;
+}
+
+bool UInventoryItemIndexSubsystem::FItemsCounter::Remove(const TObjectKey<UObject>& HolderKey, const int32 Count)
+{
+	int32* HolderCount = CountByHolder.Find(HolderKey);
+
+	if (!ensureAlwaysMsgf(HolderCount && *HolderCount >= Count, TEXT("Removing items that were never added!")))
+	{
+		return false;
+	}
+
+	TotalCount -= Count;
+	*HolderCount -= Count;
+
+	if (*HolderCount == 0)
+	{
+		CountByHolder.Remove(HolderKey);
+	}
+
+	return CountByHolder.IsEmpty();
+}
+
+void UInventoryItemIndexSubsystem::FItemsCounter::GetHolders(TArray<UObject*>& OutHolders) const
+{
+	OutHolders.Reserve(OutHolders.Num() + CountByHolder.Num());
+
+	for (const TPair<TObjectKey<UObject>, int32>& Pair : CountByHolder)
+	{
+		UObject* Holder = Pair.Key.ResolveObjectPtr();
+
+		if (IsValid(Holder))
+		{
+			OutHolders.AddUnique(Holder);
+		}
+	}
+}
+
+const FGameplayTagContainer& UInventoryItemIndexSubsystem::GetIndexedTags(
+	const TSubclassOf<UInventoryItemDefinition>& Definition)
+{
+	if (const FGameplayTagContainer* IndexedTags = IndexedTagsByDefinition.Find(Definition))
+	{
+		return *IndexedTags;
+	}
+
+	const UInventoryItemDefinition* DefinitionDefaultObject = Definition->GetDefaultObject<UInventoryItemDefinition>();
+
+	// Parent tags are indexed as well, so a query for a parent tag includes the items with any of its children
+	return IndexedTagsByDefinition.Add(Definition, DefinitionDefaultObject->GetTags().GetGameplayTagParents());
+}
+
+void UInventoryItemIndexSubsystem::AddItems(const UObject* Holder,
+	const TSubclassOf<UInventoryItemDefinition>& Definition, const int32 Count)
+{
+#if DO_CHECK
+	check(IsValid(Holder));
+	check(IsValid(Definition));
+#endif
+
+	if (Count <= 0)
+	{
+		return;
+	}
+
+	const TObjectKey<UObject> HolderKey(Holder);
+
+	CountersByDefinition.FindOrAdd(Definition).Add(HolderKey, Count);
+
+	for (const FGameplayTag& Tag : GetIndexedTags(Definition))
+	{
+		CountersByTag.FindOrAdd(Tag).Add(HolderKey, Count);
+	}
+}
+
+void UInventoryItemIndexSubsystem::RemoveItems(const UObject* Holder,
+	const TSubclassOf<UInventoryItemDefinition>& Definition, const int32 Count)
+{
+#if DO_CHECK
+	check(IsValid(Holder));
+	check(IsValid(Definition));
+#endif
+
+	if (Count <= 0)
+	{
+		return;
+	}
+
+	const TObjectKey<UObject> HolderKey(Holder);
+
+	FItemsCounter* DefinitionCounter = CountersByDefinition.Find(Definition);
+
+	if (DefinitionCounter && DefinitionCounter->Remove(HolderKey, Count))
+	{
+		CountersByDefinition.Remove(Definition);
+	}
+
+	for (const FGameplayTag& Tag : GetIndexedTags(Definition))
+	{
+		FItemsCounter* TagCounter = CountersByTag.Find(Tag);
+
+		if (TagCounter && TagCounter->Remove(HolderKey, Count))
+		{
+			CountersByTag.Remove(Tag);
+		}
+	}
+}
+
+int32 UInventoryItemIndexSubsystem::GetItemsCount(const TSubclassOf<UInventoryItemDefinition>& Definition) const
+{
+	const FItemsCounter* Counter = CountersByDefinition.Find(Definition);
+
+	return Counter ? Counter->TotalCount : 0;
+}
+
+int32 UInventoryItemIndexSubsystem::GetItemsCountByTag(const FGameplayTag& Tag) const
+{
+	const FItemsCounter* Counter = CountersByTag.Find(Tag);
+
+	return Counter ? Counter->TotalCount : 0;
+}
+
+int32 UInventoryItemIndexSubsystem::GetHolderItemsCount(const UObject* Holder,
+	const TSubclassOf<UInventoryItemDefinition>& Definition) const
+{
+	const FItemsCounter* Counter = CountersByDefinition.Find(Definition);
+
+	return Counter ? Counter->CountByHolder.FindRef(TObjectKey<UObject>(Holder)) : 0;
+}
+
+int32 UInventoryItemIndexSubsystem::GetHolderItemsCountByTag(const UObject* Holder, const FGameplayTag& Tag) const
+{
+	const FItemsCounter* Counter = CountersByTag.Find(Tag);
+
+	return Counter ? Counter->CountByHolder.FindRef(TObjectKey<UObject>(Holder)) : 0;
+}
+
+void UInventoryItemIndexSubsystem::GetHolders(const TSubclassOf<UInventoryItemDefinition>& Definition,
+	TArray<UObject*>& OutHolders) const
+{
+	OutHolders.Empty();
+
+	if (const FItemsCounter* Counter = CountersByDefinition.Find(Definition))
+	{
+		Counter->GetHolders(OutHolders);
+	}
+}
+
+void UInventoryItemIndexSubsystem::GetHoldersByTag(const FGameplayTag& Tag, TArray<UObject*>& OutHolders) const
+{
+	OutHolders.Empty();
+
+	if (const FItemsCounter* Counter = CountersByTag.Find(Tag))
+	{
+		Counter->GetHolders(OutHolders);
+	}
+}
+
+#if !UE_BUILD_SHIPPING
+/**
+ * Compares the index with a brute-force scan of all inventories and pickups in the world by counting the items of every
+ * indexed definition. Usage: Inventory.ItemIndex.Benchmark [NumIterations]
+ */
+static FAutoConsoleCommandWithWorldAndArgs InventoryItemIndexBenchmarkCommand(
+	TEXT("Inventory.ItemIndex.Benchmark"),
+	TEXT("Compares UInventoryItemIndexSubsystem queries with a brute-force scan of all inventories and pickups."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		const UInventoryItemIndexSubsystem* ItemIndexSubsystem = World->GetSubsystem<UInventoryItemIndexSubsystem>();
+
+		if (!IsValid(ItemIndexSubsystem))
+		{
+			return;
+		}
+
+		const int32 NumIterations = Args.IsEmpty() ? 1000 : FMath::Max(FCString::Atoi(*Args[0]), 1);
+
+		TArray<TSubclassOf<UInventoryItemDefinition>> Definitions;
+		ItemIndexSubsystem->GetIndexedDefinitions(Definitions);
+
+		int64 IndexedChecksum = 0;
+		const double IndexedStartTime = FPlatformTime::Seconds();
+
+		for (int32 i = 0; i < NumIterations; ++i)
+		{
+			for (const TSubclassOf<UInventoryItemDefinition>& Definition : Definitions)
+			{
+				IndexedChecksum += ItemIndexSubsystem->GetItemsCount(Definition);
+			}
+		}
+
+		const double IndexedTime = FPlatformTime::Seconds() - IndexedStartTime;
+
+		int64 BruteForceChecksum = 0;
+		const double BruteForceStartTime = FPlatformTime::Seconds();
+
+		for (int32 i = 0; i < NumIterations; ++i)
+		{
+			for (const TSubclassOf<UInventoryItemDefinition>& Definition : Definitions)
+			{
+				for (TObjectIterator<UInventoryManagerComponent> It; It; ++It)
+				{
+					if (It->GetWorld() != World)
+					{
+						continue;
+					}
+
+					for (const FInventorySlotsTypedArray& TypedArray : It->GetInventoryContent().GetItems())
+					{
+						for (const FInventorySlot& Slot : TypedArray.Array.GetItems())
+						{
+							if (IsValid(Slot.Instance) && Slot.Instance->GetDefinition() == Definition)
+							{
+								BruteForceChecksum += Slot.Instance->GetStackCount();
+							}
+						}
+					}
+				}
+
+				for (TActorIterator<AInventoryPickupItem> It(World); It; ++It)
+				{
+					// Pooled pickups keep their last item instance, but they aren't in the world or in the index
+					if (It->IsInPool())
+					{
+						continue;
+					}
+
+					const UInventoryItemInstance* ItemInstance = It->GetItemInstance();
+
+					if (IsValid(ItemInstance) && ItemInstance->GetDefinition() == Definition)
+					{
+						BruteForceChecksum += ItemInstance->GetStackCount();
+					}
+				}
+			}
+		}
+
+		const double BruteForceTime = FPlatformTime::Seconds() - BruteForceStartTime;
+
+		UE_LOG(LogInventorySystem, Display,
+			TEXT("Inventory.ItemIndex.Benchmark: %d definitions x %d iterations. Index: %.3f ms (checksum %lld). "
+				"Brute force: %.3f ms (checksum %lld)."),
+			Definitions.Num(), NumIterations, IndexedTime * 1000.0, IndexedChecksum, BruteForceTime * 1000.0,
+			BruteForceChecksum);
+	}));
+#endif
@@ -0,0 +1,175 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Subsystems/InventoryPickupItemPoolSubsystem.h"
+
+#include "InventorySystem.h"
+#include "Actors/InventoryPickupItem.h"
+#include "Objects/InventoryItemInstance.h"
+
+DECLARE_CYCLE_STAT(TEXT("Acquire Pickup"), STAT_InventoryAcquirePickup, STATGROUP_Inventory);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pickup Pool Hits"), STAT_InventoryPickupPoolHits, STATGROUP_Inventory);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pickup Pool Misses"), STAT_InventoryPickupPoolMisses, STATGROUP_Inventory);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pooled Pickups"), STAT_InventoryPooledPickups, STATGROUP_Inventory);
+
+void UInventoryPickupItemPoolSubsystem::Deinitialize()
+{
+	SET_DWORD_STAT(STAT_InventoryPooledPickups, 0);
+
+	Pools.Empty();
+	PooledPickupItemsNumber = 0;
+
+	Super::Deinitialize();
+}
+
+AInventoryPickupItem* UInventoryPickupItemPoolSubsystem::AcquirePickupItem(
+	const TSubclassOf<AInventoryPickupItem>& PickupItemClass, const UInventoryItemInstance* ItemInstance,
+	const FTransform& Transform)
+{
+	SCOPE_CYCLE_COUNTER(STAT_InventoryAcquirePickup);
+
+#if DO_CHECK
+	check(IsValid(PickupItemClass));
+	check(IsValid(ItemInstance));
+#endif
+
+#if DO_ENSURE
+	ensureAlways(GetWorld()->GetNetMode() < NM_Client);
+#endif
+
+	AInventoryPickupItem* PickupItem = PopPickupItem(PickupItemClass);
+
+	if (!PickupItem)
+	{
+		++MissesNumber;
+		INC_DWORD_STAT(STAT_InventoryPickupPoolMisses);
+
+		return SpawnPickupItem(PickupItemClass, ItemInstance, Transform);
+	}
+
+	++HitsNumber;
+	INC_DWORD_STAT(STAT_InventoryPickupPoolHits);
+
+	PickupItem->ActivateFromPool(ItemInstance->Duplicate(PickupItem), Transform);
+
+	return PickupItem;
+}
+
+AInventoryPickupItem* UInventoryPickupItemPoolSubsystem::PopPickupItem(
+	const TSubclassOf<AInventoryPickupItem>& PickupItemClass)
+{
+	FInventoryPickupItemsPool* Pool = Pools.Find(PickupItemClass);
+
+	if (!Pool)
+	{
+		return nullptr;
+	}
+
+	while (!Pool->PickupItems.IsEmpty())
+	{
+		AInventoryPickupItem* PickupItem = Pool->PickupItems.Pop(EAllowShrinking::No);
+
+		--PooledPickupItemsNumber;
+		SET_DWORD_STAT(STAT_InventoryPooledPickups, PooledPickupItemsNumber);
+
+		if (IsValid(PickupItem))
+		{
+			return PickupItem;
+		}
+	}
+
+	return nullptr;
+}
+
+AInventoryPickupItem* UInventoryPickupItemPoolSubsystem::SpawnPickupItem(
+	const TSubclassOf<AInventoryPickupItem>& PickupItemClass, const UInventoryItemInstance* ItemInstance,
+	const FTransform& Transform) const
+{
+	AInventoryPickupItem* PickupItem = GetWorld()->SpawnActorDeferred<AInventoryPickupItem>(PickupItemClass,
+		Transform);
+
+	if (!ensureAlways(IsValid(PickupItem)))
+	{
+		return nullptr;
+	}
+
+	PickupItem->SetItemInstance(ItemInstance->Duplicate(PickupItem));
+
+#if DO_CHECK
+	check(IsValid(PickupItem->GetItemInstance()));
+#endif
+
+	PickupItem->FinishSpawning(Transform);
+
+	return PickupItem;
+}
+
+void UInventoryPickupItemPoolSubsystem::ReleasePickupItem(AInventoryPickupItem* PickupItem)
+{
+#if DO_CHECK
+	check(IsValid(PickupItem));
+#endif
+
+	if (!ensureAlways(!PickupItem->IsInPool()))
+	{
+		return;
+	}
+
+	FInventoryPickupItemsPool& Pool = Pools.FindOrAdd(PickupItem->GetClass());
+
+	if (Pool.PickupItems.Num() >= MaxPoolSizePerClass)
+	{
+		PickupItem->Destroy();
+
+		return;
+	}
+
+	PickupItem->DeactivateToPool();
+
+	Pool.PickupItems.Add(PickupItem);
+
+	++PooledPickupItemsNumber;
+	SET_DWORD_STAT(STAT_InventoryPooledPickups, PooledPickupItemsNumber);
+}
+
+int32 UInventoryPickupItemPoolSubsystem::GetPoolSize(const TSubclassOf<AInventoryPickupItem>& PickupItemClass) const
+{
+	const FInventoryPickupItemsPool* Pool = Pools.Find(PickupItemClass);
+
+	return Pool ? Pool->PickupItems.Num() : 0;
+}
+
+float UInventoryPickupItemPoolSubsystem::GetHitRate() const
+{
+	const int32 AcquisitionsNumber = HitsNumber + MissesNumber;
+
+	return AcquisitionsNumber > 0 ? static_cast<float>(HitsNumber) / AcquisitionsNumber : 0;
+}
+
+void UInventoryPickupItemPoolSubsystem::LogPoolsState() const
+{
+	UE_LOG(LogInventorySystem, Display, TEXT("Pickup pools: %d pooled pickups, %d hits, %d misses, hit rate %.1f%%"),
+		PooledPickupItemsNumber, HitsNumber, MissesNumber, GetHitRate() * 100);
+
+	for (const TPair<TSubclassOf<AInventoryPickupItem>, FInventoryPickupItemsPool>& Pair : Pools)
+	{
+		UE_LOG(LogInventorySystem, Display, TEXT("    %s: %d/%d"), *GetNameSafe(Pair.Key),
+			Pair.Value.PickupItems.Num(), MaxPoolSizePerClass);
+	}
+}
+
+#if !UE_BUILD_SHIPPING
+// Usage: Inventory.PickupPool.Log
+static FAutoConsoleCommandWithWorld InventoryPickupPoolLogCommand(
+	TEXT("Inventory.PickupPool.Log"),
+	TEXT("Prints the sizes of the pickup pools and their hit rate."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		const UInventoryPickupItemPoolSubsystem* PickupItemPoolSubsystem =
+			World->GetSubsystem<UInventoryPickupItemPoolSubsystem>();
+
+		if (IsValid(PickupItemPoolSubsystem))
+		{
+			PickupItemPoolSubsystem->LogPoolsState();
+		}
+	}));
+#endif
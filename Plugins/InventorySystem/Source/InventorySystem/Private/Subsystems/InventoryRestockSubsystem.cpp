@@ -0,0 +1,171 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Subsystems/InventoryRestockSubsystem.h"
+
+#include "InventorySystem.h"
+#include "ActorComponents/InventoryManagerComponent.h"
+#include "Objects/InventoryItemInstance.h"
+
+DECLARE_CYCLE_STAT(TEXT("Restock Tick"), STAT_InventoryRestockTick, STATGROUP_Inventory);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Restocked Items"), STAT_InventoryRestockedItems, STATGROUP_Inventory);
+
+bool UInventoryRestockSubsystem::IsTickable() const
+{
+	return Super::IsTickable() && IsRestockInProgress();
+}
+
+TStatId UInventoryRestockSubsystem::GetStatId() const
+{
+	return GET_STATID(STAT_InventoryRestockTick);
+}
+
+void UInventoryRestockSubsystem::EnqueueJobs(const TArray<FInventoryRestockJob>& Jobs)
+{
+#if DO_ENSURE
+	ensureAlways(GetWorld()->GetNetMode() < NM_Client);
+#endif
+
+	// Start a new restock if the previous one is already finished
+	if (!IsRestockInProgress())
+	{
+		PendingJobs.Reset();
+		PendingPortions.Reset();
+
+		CurrentPortionIndex = 0;
+		CompletedItemsNumber = 0;
+		TotalItemsNumber = 0;
+	}
+
+	for (const FInventoryRestockJob& Job : Jobs)
+	{
+		if (!ensureAlways(Job.Inventory.IsValid()) || !ensureAlways(IsValid(Job.Definition)) || Job.Count <= 0)
+		{
+			continue;
+		}
+
+		const int32 JobIndex = PendingJobs.Add(Job);
+		TotalItemsNumber += Job.Count;
+
+		const int32 MaxStackCount = Job.Definition->GetDefaultObject<UInventoryItemDefinition>()->GetMaxStackCount();
+
+		// Create all items of the job now, so the ticks only have to put them into the slots
+		for (int32 RemainingCount = Job.Count; RemainingCount > 0;)
+		{
+			const int32 PortionCount = FMath::Min(RemainingCount, MaxStackCount);
+
+			UInventoryItemInstance* ItemInstance = NewObject<UInventoryItemInstance>(Job.Inventory.Get());
+			ItemInstance->Initialize(Job.Definition, PortionCount);
+
+			FInventoryRestockPortion& Portion = PendingPortions.AddDefaulted_GetRef();
+			Portion.ItemInstance = ItemInstance;
+			Portion.JobIndex = JobIndex;
+
+			RemainingCount -= PortionCount;
+		}
+	}
+}
+
+void UInventoryRestockSubsystem::Tick(const float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	const double Deadline = FPlatformTime::Seconds() + FrameBudgetMilliseconds / 1000.0;
+
+	// Always apply at least one portion to guarantee the progress even with a tiny budget
+	do
+	{
+		ApplyNextPortion();
+	}
+	while (IsRestockInProgress() && FPlatformTime::Seconds() < Deadline);
+
+	OnRestockProgress.Broadcast(CompletedItemsNumber, TotalItemsNumber);
+
+	if (!IsRestockInProgress())
+	{
+		FinishRestock();
+	}
+}
+
+void UInventoryRestockSubsystem::ApplyNextPortion()
+{
+	const FInventoryRestockPortion& Portion = PendingPortions[CurrentPortionIndex];
+	const FInventoryRestockJob& Job = PendingJobs[Portion.JobIndex];
+
+	UInventoryManagerComponent* Inventory = Job.Inventory.Get();
+
+	// The inventory could be destroyed while the job was waiting in the queue
+	if (!IsValid(Inventory))
+	{
+		CompletedItemsNumber += SkipJobPortions(Portion.JobIndex);
+
+		return;
+	}
+
+	UInventoryItemInstance* ItemInstance = Portion.ItemInstance;
+	const int32 JobIndex = Portion.JobIndex;
+
+	const int32 PortionCount = ItemInstance->GetStackCount();
+	const int32 AddedCount = FMath::Min(PortionCount, Inventory->GetFreeSpaceFor(ItemInstance, Job.SlotTypeTag));
+
+	/**
+	 * AddItemInstance adds nothing if the whole portion doesn't fit, so only the part that still fits is added. This
+	 * only happens once per job, since the rest of the job is skipped then.
+	 */
+	if (AddedCount > 0 && AddedCount < PortionCount)
+	{
+		ItemInstance = NewObject<UInventoryItemInstance>(Inventory);
+		ItemInstance->Initialize(Job.Definition, AddedCount);
+	}
+
+	const bool bAdded = AddedCount > 0 &&
+		ensureAlways(Inventory->AddItemInstance(ItemInstance, INDEX_NONE, Job.SlotTypeTag));
+
+	if (bAdded)
+	{
+		INC_DWORD_STAT_BY(STAT_InventoryRestockedItems, AddedCount);
+
+		CompletedItemsNumber += AddedCount;
+	}
+
+	if (bAdded && AddedCount == PortionCount)
+	{
+		++CurrentPortionIndex;
+
+		return;
+	}
+
+	// Only the part of the current portion that wasn't added is skipped
+	const int32 NotAddedCount = PortionCount - (bAdded ? AddedCount : 0);
+	++CurrentPortionIndex;
+
+	const int32 SkippedCount = NotAddedCount + SkipJobPortions(JobIndex);
+
+	UE_LOG(LogInventorySystem, Warning,
+		TEXT("UInventoryRestockSubsystem: Inventory of %s is full, %d items of %s were skipped"),
+		*Inventory->GetOwner()->GetName(), SkippedCount, *Job.Definition->GetName());
+
+	CompletedItemsNumber += SkippedCount;
+}
+
+int32 UInventoryRestockSubsystem::SkipJobPortions(const int32 JobIndex)
+{
+	int32 SkippedCount = 0;
+
+	while (IsRestockInProgress() && PendingPortions[CurrentPortionIndex].JobIndex == JobIndex)
+	{
+		SkippedCount += PendingPortions[CurrentPortionIndex].ItemInstance->GetStackCount();
+		++CurrentPortionIndex;
+	}
+
+	return SkippedCount;
+}
+
+void UInventoryRestockSubsystem::FinishRestock()
+{
+	PendingJobs.Empty();
+	PendingPortions.Empty();
+
+	CurrentPortionIndex = 0;
+
+	OnRestockCompleted.Broadcast();
+}
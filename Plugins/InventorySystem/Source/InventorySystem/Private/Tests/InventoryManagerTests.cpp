@@ -0,0 +1,292 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "InventorySystemGameplayTags.h"
+#include "InventoryTestItemDefinition.h"
+#include "ActorComponents/InventoryManagerComponent.h"
+#include "Common/Structs/SaveData/InventorySaveData.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "GameFramework/WorldSettings.h"
+#include "NativeGameplayTags.h"
+#include "Objects/InventoryItemInstance.h"
+#include "UObject/UnrealType.h"
+
+namespace InventoryManagerTests
+{
+	UE_DEFINE_GAMEPLAY_TAG_STATIC(TestStatTag, "Inventory.Item.Stat.Test");
+
+	constexpr EAutomationTestFlags TestFlags = EAutomationTestFlags_ApplicationContextMask |
+		EAutomationTestFlags::EngineFilter;
+
+	constexpr int32 SlotsNumber = 4;
+
+	// Default max stack count of UStackableInventoryItemFragment
+	constexpr int32 MaxStackCount = 20;
+
+	// Headless game world with a single inventory of SlotsNumber main slots
+	class FTestInventory
+	{
+	public:
+		FTestInventory()
+		{
+			World = UWorld::CreateWorld(EWorldType::Game, false);
+
+			FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+			WorldContext.SetCurrentWorld(World);
+
+			World->InitializeActorsForPlay(FURL());
+
+			// There is no game mode to start the play, so the actors are notified directly
+			World->GetWorldSettings()->NotifyBeginPlay();
+
+			AActor* Owner = World->SpawnActor<AActor>();
+			Inventory = NewObject<UInventoryManagerComponent>(Owner);
+
+			// The slots are constructed from this map on BeginPlay, which is called by the registration
+			FindFProperty<FMapProperty>(UInventoryManagerComponent::StaticClass(), TEXT("SlotsNumberByTypes"))->
+				ContainerPtrToValuePtr<TMap<FGameplayTag, int32>>(Inventory)->Add(
+					InventorySystemGameplayTags::Inventory_Slot_Type_Main, SlotsNumber);
+
+			Owner->AddInstanceComponent(Inventory);
+			Inventory->RegisterComponent();
+		}
+
+		~FTestInventory()
+		{
+			GEngine->DestroyWorldContext(World);
+			World->DestroyWorld(false);
+		}
+
+		UInventoryManagerComponent* operator->() const { return Inventory; }
+
+		// Creates an item to be added to the inventory. Only duplicates of it are stored in the slots.
+		static UInventoryItemInstance* CreateItem(const int32 StackCount)
+		{
+			UInventoryItemInstance* ItemInstance = NewObject<UInventoryItemInstance>(GetTransientPackage());
+			ItemInstance->Initialize(UInventoryTestItemDefinition::StaticClass(), StackCount);
+
+			return ItemInstance;
+		}
+
+		/**
+		 * Checks the stack count in each slot of the inventory.
+		 * @param ExpectedStackCounts Stack count for each slot. Zero means that the slot must be empty.
+		 */
+		void TestSlots(FAutomationTestBase& Test, const FString& What,
+			const TArray<int32>& ExpectedStackCounts) const
+		{
+			for (int32 SlotIndex = 0; SlotIndex < SlotsNumber; ++SlotIndex)
+			{
+				const UInventoryItemInstance* ItemInstance = Inventory->GetItemInstance(SlotIndex);
+				const FString SlotWhat = FString::Printf(TEXT("%s: slot %d"), *What, SlotIndex);
+
+				if (ExpectedStackCounts[SlotIndex] == 0)
+				{
+					Test.TestNull(SlotWhat, ItemInstance);
+				}
+				else if (Test.TestNotNull(SlotWhat, ItemInstance))
+				{
+					Test.TestEqual(SlotWhat + TEXT(" stack count"), ItemInstance->GetStackCount(),
+						ExpectedStackCounts[SlotIndex]);
+				}
+			}
+		}
+
+	private:
+		UWorld* World = nullptr;
+		UInventoryManagerComponent* Inventory = nullptr;
+	};
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInventoryManagerAddItemTest, "InventorySystem.InventoryManager.AddItem",
+	InventoryManagerTests::TestFlags)
+
+bool FInventoryManagerAddItemTest::RunTest(const FString& Parameters)
+{
+	using namespace InventoryManagerTests;
+
+	const FTestInventory Inventory;
+
+	TestTrue(TEXT("Add to an empty slot"), Inventory->AddItem(FTestInventory::CreateItem(5), 2));
+	Inventory.TestSlots(*this, TEXT("Add to an empty slot"), { 0, 0, 5, 0 });
+
+	TestTrue(TEXT("Add to the existing stack"), Inventory->AddItem(FTestInventory::CreateItem(10)));
+	Inventory.TestSlots(*this, TEXT("Add to the existing stack"), { 0, 0, 15, 0 });
+
+	TestTrue(TEXT("Add over the existing stack"), Inventory->AddItem(FTestInventory::CreateItem(MaxStackCount)));
+	Inventory.TestSlots(*this, TEXT("Add over the existing stack"), { 15, 0, MaxStackCount, 0 });
+
+	// Each of these fills the last stack and puts the rest into the next empty slot
+	Inventory->AddItem(FTestInventory::CreateItem(MaxStackCount));
+	Inventory->AddItem(FTestInventory::CreateItem(MaxStackCount));
+
+	TestEqual(TEXT("Free space of the full inventory"),
+		Inventory->GetFreeSpaceFor(FTestInventory::CreateItem(1)), MaxStackCount - 15);
+
+	TestFalse(TEXT("Add more than fits"), Inventory->AddItem(FTestInventory::CreateItem(MaxStackCount)));
+	Inventory.TestSlots(*this, TEXT("Add more than fits"), { MaxStackCount, MaxStackCount, MaxStackCount, 15 });
+
+	TMap<TSubclassOf<UInventoryItemDefinition>, int32> ItemsCount;
+	Inventory->GatherItemsCount(ItemsCount);
+
+	TestEqual(TEXT("Gathered items count"), ItemsCount.FindRef(UInventoryTestItemDefinition::StaticClass()),
+		15 + MaxStackCount * 3);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInventoryManagerSplitMergeMoveTest,
+	"InventorySystem.InventoryManager.SplitMergeMove", InventoryManagerTests::TestFlags)
+
+bool FInventoryManagerSplitMergeMoveTest::RunTest(const FString& Parameters)
+{
+	using namespace InventoryManagerTests;
+
+	const FTestInventory Inventory;
+
+	Inventory->AddItem(FTestInventory::CreateItem(10), 0);
+
+	TestTrue(TEXT("Split to the given slot"), Inventory->SplitItem(0, 3, 2));
+	Inventory.TestSlots(*this, TEXT("Split to the given slot"), { 7, 0, 3, 0 });
+
+	TestTrue(TEXT("Split to an empty slot"), Inventory->SplitItem(0, 2));
+	Inventory.TestSlots(*this, TEXT("Split to an empty slot"), { 5, 2, 3, 0 });
+
+	TestFalse(TEXT("Split the whole stack"), Inventory->SplitItem(0, 5));
+	TestFalse(TEXT("Split to an occupied slot"), Inventory->SplitItem(0, 1, 1));
+	Inventory.TestSlots(*this, TEXT("Rejected splits"), { 5, 2, 3, 0 });
+
+	TestTrue(TEXT("Split creates a new item"), Inventory->GetItemInstance(0) != Inventory->GetItemInstance(2));
+
+	TestTrue(TEXT("Merge the whole stack"), Inventory->MergeItems(1, 2));
+	Inventory.TestSlots(*this, TEXT("Merge the whole stack"), { 5, 0, 5, 0 });
+
+	UInventoryItemInstance* MovedItemInstance = Inventory->GetItemInstance(2);
+
+	TestTrue(TEXT("Move to an empty slot"), Inventory->MoveItem(2, 3));
+	Inventory.TestSlots(*this, TEXT("Move to an empty slot"), { 5, 0, 0, 5 });
+	TestTrue(TEXT("Move keeps the item"), Inventory->GetItemInstance(3) == MovedItemInstance);
+
+	TestFalse(TEXT("Move to an occupied slot"), Inventory->MoveItem(3, 0));
+	TestFalse(TEXT("Move from an empty slot"), Inventory->MoveItem(1, 2));
+	Inventory.TestSlots(*this, TEXT("Rejected moves"), { 5, 0, 0, 5 });
+
+	Inventory->AddItem(FTestInventory::CreateItem(MaxStackCount - 2), 1);
+
+	TestTrue(TEXT("Merge a part of the stack"), Inventory->MergeItems(0, 1));
+	Inventory.TestSlots(*this, TEXT("Merge a part of the stack"), { 3, MaxStackCount, 0, 5 });
+
+	TestFalse(TEXT("Merge into a full stack"), Inventory->MergeItems(3, 1));
+	Inventory.TestSlots(*this, TEXT("Merge into a full stack"), { 3, MaxStackCount, 0, 5 });
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInventoryManagerConsumeDeleteTest,
+	"InventorySystem.InventoryManager.ConsumeDelete", InventoryManagerTests::TestFlags)
+
+bool FInventoryManagerConsumeDeleteTest::RunTest(const FString& Parameters)
+{
+	using namespace InventoryManagerTests;
+
+	const FTestInventory Inventory;
+
+	Inventory->AddItem(FTestInventory::CreateItem(5), 0);
+	Inventory->AddItem(FTestInventory::CreateItem(MaxStackCount), 1);
+
+	TestTrue(TEXT("Consume a part of the stack"), Inventory->ConsumeItem(0, 2));
+	Inventory.TestSlots(*this, TEXT("Consume a part of the stack"), { 3, MaxStackCount, 0, 0 });
+
+	TestTrue(TEXT("Consume the whole stack"), Inventory->ConsumeItem(0, 3));
+	Inventory.TestSlots(*this, TEXT("Consume the whole stack"), { 0, MaxStackCount, 0, 0 });
+
+	TestTrue(TEXT("Delete an item"), Inventory->DeleteItem(1));
+	TestFalse(TEXT("Delete from an empty slot"), Inventory->DeleteItem(1));
+	Inventory.TestSlots(*this, TEXT("Delete"), { 0, 0, 0, 0 });
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInventoryManagerStatsTest, "InventorySystem.InventoryManager.Stats",
+	InventoryManagerTests::TestFlags)
+
+bool FInventoryManagerStatsTest::RunTest(const FString& Parameters)
+{
+	using namespace InventoryManagerTests;
+
+	const FTestInventory Inventory;
+
+	Inventory->AddItem(FTestInventory::CreateItem(5), 0);
+	Inventory->AddItem(FTestInventory::CreateItem(5), 1);
+
+	TestTrue(TEXT("Set a stat"), Inventory->SetItemInstanceStat(1, FInstanceStatsItem(TestStatTag, 7)));
+
+	const FInstanceStatsItem* Stat = Inventory->GetItemInstance(1)->GetInstanceStats().GetStat(TestStatTag);
+
+	if (TestNotNull(TEXT("Set stat"), Stat))
+	{
+		TestEqual(TEXT("Set stat value"), Stat->Value, 7.0f);
+	}
+
+	TestFalse(TEXT("Merge items with different stats"), Inventory->MergeItems(0, 1));
+
+	TestTrue(TEXT("Set a stack count above the max"), Inventory->SetItemInstanceStat(0,
+		FInstanceStatsItem(InventorySystemGameplayTags::Inventory_Item_Stat_StackCount, MaxStackCount + 5)));
+
+	Inventory.TestSlots(*this, TEXT("Set a stack count above the max"), { MaxStackCount, 5, 0, 0 });
+
+	Inventory->SetItemInstanceStat(0, FInstanceStatsItem(InventorySystemGameplayTags::Inventory_Item_Stat_StackCount,
+		0));
+
+	Inventory.TestSlots(*this, TEXT("Set a zero stack count"), { 0, 5, 0, 0 });
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FInventoryManagerSaveLoadTest, "InventorySystem.InventoryManager.SaveLoad",
+	InventoryManagerTests::TestFlags)
+
+bool FInventoryManagerSaveLoadTest::RunTest(const FString& Parameters)
+{
+	using namespace InventoryManagerTests;
+
+	const FTestInventory Inventory;
+
+	Inventory->AddItem(FTestInventory::CreateItem(1), 0);
+	Inventory->AddItem(FTestInventory::CreateItem(12), 2);
+	Inventory->SetItemInstanceStat(2, FInstanceStatsItem(TestStatTag, 3));
+
+	FInventorySaveData SaveData;
+	Inventory->SaveContent(SaveData);
+
+	TestEqual(TEXT("Saved definitions"), SaveData.Definitions.Num(), 1);
+
+	// The stack count of the first item is equal to the default one, so it isn't saved
+	if (TestEqual(TEXT("Saved slots"), SaveData.Slots.Num(), 2))
+	{
+		TestEqual(TEXT("Changed stats of the default item"), SaveData.Slots[0].ChangedStats.Num(), 0);
+		TestEqual(TEXT("Changed stats of the changed item"), SaveData.Slots[1].ChangedStats.Num(), 2);
+	}
+
+	Inventory->DeleteItem(0);
+	Inventory->AddItem(FTestInventory::CreateItem(4), 3);
+
+	Inventory->LoadContent(SaveData);
+	Inventory.TestSlots(*this, TEXT("Load"), { 1, 0, 12, 0 });
+
+	const FInstanceStatsItem* Stat = Inventory->GetItemInstance(2)->GetInstanceStats().GetStat(TestStatTag);
+
+	if (TestNotNull(TEXT("Loaded stat"), Stat))
+	{
+		TestEqual(TEXT("Loaded stat value"), Stat->Value, 3.0f);
+	}
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,28 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Objects/InventoryItemDefinition.h"
+#include "Objects/InventoryItemFragments/StackableInventoryItemFragment.h"
+#include "UObject/UnrealType.h"
+#include "InventoryTestItemDefinition.generated.h"
+
+/**
+ * Stackable item definition for the automation tests. The content doesn't have any native item definitions, and the
+ * tests must not patch the shared base definition, so they use this one instead.
+ */
+UCLASS(NotBlueprintable, HideDropdown)
+class UInventoryTestItemDefinition : public UInventoryItemDefinition
+{
+	GENERATED_BODY()
+
+public:
+	UInventoryTestItemDefinition()
+	{
+		// The fragments are private to the base definition, so they are filled via reflection, just as in an asset
+		FindFProperty<FArrayProperty>(UInventoryItemDefinition::StaticClass(), TEXT("Fragments"))->
+			ContainerPtrToValuePtr<TArray<TObjectPtr<UInventoryItemFragment>>>(this)->Add(
+				CreateDefaultSubobject<UStackableInventoryItemFragment>(TEXT("StackableFragment")));
+	}
+};
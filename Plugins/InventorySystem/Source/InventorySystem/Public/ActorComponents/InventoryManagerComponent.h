@@ -4,9 +4,15 @@
 
 #include "GameplayTagContainer.h"
 #include "InventorySystemGameplayTags.h"
+#include "Common/Enums/InventoryItemsReplicationPolicy.h"
+#include "Common/Structs/InventoryContentChange.h"
+#include "Common/Structs/SaveData/InventorySaveData.h"
+#include "Common/Structs/FastArraySerializers/InventoryFlatSlotsArray.h"
 #include "Common/Structs/FastArraySerializers/InventorySlotsTypedArrayContainer.h"
 #include "InventoryManagerComponent.generated.h"
 
+class APlayerController;
+class UInventoryItemIndexSubsystem;
 class UInventoryManagerFragment;
 
 /**
@@ -24,10 +30,20 @@ class INVENTORYSYSTEM_API UInventoryManagerComponent : public UActorComponent
 public:
 	UInventoryManagerComponent();
 
+	virtual void PostInitProperties() override;
+
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+	virtual void GetReplicatedCustomConditionState(FCustomPropertyConditionState& OutActiveState) const override;
 
 	const FInventorySlotsTypedArrayContainer& GetInventoryContent() { return InventoryContent; }
 
+	/**
+	 * Whether the slots are replicated with the flat layout (FInventoryFlatSlotsArray) instead of the nested
+	 * FInventorySlotsTypedArrayContainer. Taken from the Inventory.FlatSlotsReplication console variable when the
+	 * component is created, so changing the variable at runtime only affects the inventories created afterward.
+	 */
+	bool IsFlatSlotsReplicationEnabled() const { return bFlatSlotsReplication; }
+
 	// Returns the first fragment of type T, or nullptr if none exists
 	template<typename T>
 	T* GetFragmentByClass() const;
@@ -42,14 +58,31 @@ public:
 		const FGameplayTag& SlotTypeTag = InventorySystemGameplayTags::Inventory_Slot_Type_Main) const;
 
 	/**
-	 * Adds a DUPLICATE of the given item to the inventory.
+	 * Adds a DUPLICATE of the given item to the inventory. Stackable items are merged into the existing stacks of the
+	 * same item first, and the rest is put into empty slots. The item is added only if its whole stack fits.
 	 * @param ItemInstance The item being copied.
-	 * @param SlotIndex Index of the slot (if INDEX_NONE, searches for an empty slot).
+	 * @param SlotIndex Index of the slot (if INDEX_NONE, searches for existing stacks and empty slots).
 	 * @param SlotTypeTag Type of the slot.
 	 */
 	bool AddItem(const UInventoryItemInstance* ItemInstance, int32 SlotIndex = INDEX_NONE,
 		const FGameplayTag& SlotTypeTag = InventorySystemGameplayTags::Inventory_Slot_Type_Main);
 
+	/**
+	 * Same as AddItem, but the given item is put into the first slot that needs a new item instead of its duplicate, so
+	 * items created in advance can be added without creating any objects. The item isn't used if it's fully merged
+	 * into the existing stacks.
+	 * @param ItemInstance Item that isn't in any inventory yet. Must be created with this component as the Outer.
+	 */
+	bool AddItemInstance(UInventoryItemInstance* ItemInstance, int32 SlotIndex = INDEX_NONE,
+		const FGameplayTag& SlotTypeTag = InventorySystemGameplayTags::Inventory_Slot_Type_Main);
+
+	/**
+	 * Returns how many items of the same kind as the given item can be added to the slots of the type by AddItem with
+	 * the automatic search: the free space in the existing stacks of the item and in the empty slots.
+	 */
+	int32 GetFreeSpaceFor(const UInventoryItemInstance* ItemInstance,
+		const FGameplayTag& SlotTypeTag = InventorySystemGameplayTags::Inventory_Slot_Type_Main) const;
+
 	/**
 	 * Deletes an item from the inventory.
 	 * @param SlotIndex Index of the slot.
@@ -58,9 +91,112 @@ public:
 	bool DeleteItem(const int32 SlotIndex,
 		const FGameplayTag& SlotTypeTag = InventorySystemGameplayTags::Inventory_Slot_Type_Main);
 
-	DECLARE_MULTICAST_DELEGATE(FOnContentChangedDelegate);
+	/**
+	 * Moves a part of the stack into another slot as a new item instance.
+	 * @param SlotIndex Index of the slot with the stack to split.
+	 * @param SplitCount Number of items to move. Must be less than the stack count.
+	 * @param TargetSlotIndex Index of an empty slot to move the items to (if INDEX_NONE, searches for an empty slot).
+	 * @param SlotTypeTag Type of both slots.
+	 */
+	bool SplitItem(const int32 SlotIndex, const int32 SplitCount, int32 TargetSlotIndex = INDEX_NONE,
+		const FGameplayTag& SlotTypeTag = InventorySystemGameplayTags::Inventory_Slot_Type_Main);
+
+	/**
+	 * Moves as many items as possible from one stack to another one of the same item. The source slot is cleared if all
+	 * of its items were moved.
+	 * @param SourceSlotIndex Index of the slot to take the items from.
+	 * @param TargetSlotIndex Index of the slot to put the items to.
+	 * @param SlotTypeTag Type of both slots.
+	 */
+	bool MergeItems(const int32 SourceSlotIndex, const int32 TargetSlotIndex,
+		const FGameplayTag& SlotTypeTag = InventorySystemGameplayTags::Inventory_Slot_Type_Main);
+
+	/**
+	 * Moves the whole item from one slot to another empty one.
+	 * @param SourceSlotIndex Index of the slot with the item.
+	 * @param TargetSlotIndex Index of the empty slot to move the item to.
+	 * @param SlotTypeTag Type of both slots.
+	 */
+	bool MoveItem(const int32 SourceSlotIndex, const int32 TargetSlotIndex,
+		const FGameplayTag& SlotTypeTag = InventorySystemGameplayTags::Inventory_Slot_Type_Main);
+
+	/**
+	 * Removes the given number of items from the stack. The slot is cleared if the whole stack was consumed.
+	 * @param SlotIndex Index of the slot.
+	 * @param Count Number of items to remove. Must not exceed the stack count.
+	 * @param SlotTypeTag Type of the slot.
+	 */
+	bool ConsumeItem(const int32 SlotIndex, const int32 Count = 1,
+		const FGameplayTag& SlotTypeTag = InventorySystemGameplayTags::Inventory_Slot_Type_Main);
+
+	/**
+	 * Adds a new stat or rewrites the value of the existing one for the item in the slot. Stats of the items in the
+	 * inventory must only be changed via this function, so the item index stays in sync and the change is notified.
+	 * @param SlotIndex Index of the slot.
+	 * @param Stat Stat to set. The stack count is clamped to the max stack count, and the item is removed if it's zero
+	 * or less.
+	 * @param SlotTypeTag Type of the slot.
+	 */
+	bool SetItemInstanceStat(const int32 SlotIndex, const FInstanceStatsItem& Stat,
+		const FGameplayTag& SlotTypeTag = InventorySystemGameplayTags::Inventory_Slot_Type_Main);
+
+	/**
+	 * Writes the content of the inventory into the compact save record. The stats are saved only if they differ from
+	 * the stats of a newly initialized item of the same definition.
+	 */
+	void SaveContent(FInventorySaveData& OutSaveData) const;
+
+	/**
+	 * Replaces the content of the inventory with the items from the save record. If the slots aren't constructed yet,
+	 * the content is loaded right after they are. Must be called on the server.
+	 */
+	void LoadContent(const FInventorySaveData& SaveData);
+
+	/**
+	 * Creates initialized item instances for all slots of the save record in bulk (each definition is loaded only
+	 * once).
+	 * @param OutItemInstances Item instances in the same order as the slots of the save record. Null for the slots with
+	 * invalid data.
+	 */
+	static void CreateItemInstances(const FInventorySaveData& SaveData, UObject* Outer,
+		TArray<UInventoryItemInstance*>& OutItemInstances);
+
+	// Gathers the total number of items of each definition in all slots of the inventory
+	void GatherItemsCount(TMap<TSubclassOf<UInventoryItemDefinition>, int32>& OutItemsCount) const;
+
+	EInventoryItemsReplicationPolicy GetItemsReplicationPolicy() const { return ItemsReplicationPolicy; }
 
-	// Called when the contents of inventory slot changed
+	/**
+	 * Sets which connections receive the item instances of this inventory.
+	 * @remark Must be called before the component is ready for replication (e.g., in the owner's constructor).
+	 */
+	void SetItemsReplicationPolicy(const EInventoryItemsReplicationPolicy NewItemsReplicationPolicy);
+
+	/**
+	 * Starts replicating the item instances of this inventory to the given player (e.g., when the player opens a
+	 * container). Only works with the Subscribers replication policy.
+	 */
+	void AddSubscriber(APlayerController* PlayerController);
+
+	// Stops replicating the item instances of this inventory to the given player (e.g., when the player closes it)
+	void RemoveSubscriber(APlayerController* PlayerController);
+
+	bool IsSubscriber(const APlayerController* PlayerController) const;
+
+	/**
+	 * Forgets the subscribers that were destroyed (e.g., the players who left the game). Their net condition groups
+	 * are destroyed with them, so only the array is cleaned up. Called by AddSubscriber and RemoveSubscriber too.
+	 */
+	void RemoveInvalidSubscribers();
+
+	const TArray<TWeakObjectPtr<APlayerController>>& GetSubscribers() const { return Subscribers; }
+
+	DECLARE_MULTICAST_DELEGATE_OneParam(FOnContentChangedDelegate, const FInventoryContentChange& Change);
+
+	/**
+	 * Called for each changed slot. Fired by the mutations on the server and by the replication of the slots on
+	 * clients, so listeners can update only the changed slot instead of rescanning the whole inventory.
+	 */
 	FOnContentChangedDelegate OnContentChanged;
 
 protected:
@@ -68,6 +204,8 @@ protected:
 
 	virtual void ReadyForReplication() override;
 
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	// Executes Action for each valid item instance in inventory
 	void ForEachInventoryItemInstance(const TFunctionRef<void(UInventoryItemInstance*)>& Action) const;
 
@@ -77,6 +215,64 @@ protected:
 #endif
 
 private:
+	/**
+	 * Finds which inventory array corresponds to the requested slot type.
+	 * @return Index of the slots array or INDEX_NONE if there is no array of such type.
+	 */
+	int32 GetSlotsArrayIndex(const FGameplayTag& SlotTypeTag) const;
+
+	/**
+	 * Implements AddItem and AddItemInstance.
+	 * @param OwnedItemInstance ItemInstance itself if it can be put into a slot, or null to always duplicate it.
+	 */
+	bool AddItemInternal(const UInventoryItemInstance* ItemInstance, UInventoryItemInstance* OwnedItemInstance,
+		int32 SlotIndex, const FGameplayTag& SlotTypeTag);
+
+	/**
+	 * Puts the given item instance into the slot (or clears the slot if NewInstance is null) and starts/stops the
+	 * replication of the affected item instances.
+	 */
+	void SetSlotInstance(UInventoryItemInstance* NewInstance, const int32 SlotsArrayIndex, const int32 SlotIndex);
+
+	// Changes the stack count of an item instance that is already stored in the slot
+	void SetItemStackCount(const int32 SlotsArrayIndex, const int32 SlotIndex, const int32 NewStackCount);
+
+	// Starts replicating the given item instance to the connections allowed by ItemsReplicationPolicy
+	void AddItemInstanceReplicatedSubObject(UInventoryItemInstance* ItemInstance);
+
+	friend struct FInventoryFlatSlot;
+
+	/**
+	 * Puts the item instance received by the flat replication layout into the inventory content on the client.
+	 * @return The previous item instance of the slot.
+	 */
+	UInventoryItemInstance* SetReplicatedSlotInstance(UInventoryItemInstance* NewInstance,
+		const FGameplayTag& SlotTypeTag, const int32 SlotIndex)
+	{
+		return InventoryContent.SetReplicatedInstance(NewInstance, SlotTypeTag, SlotIndex);
+	}
+
+	void RemoveItemInstanceReplicatedSubObject(UInventoryItemInstance* ItemInstance);
+
+	/**
+	 * Determines which connections receive the item instances of this inventory. The slots themselves are replicated
+	 * to everyone, but they only reference the item instances, which carry the actual data.
+	 */
+	UPROPERTY(EditDefaultsOnly, Category="Replication")
+	EInventoryItemsReplicationPolicy ItemsReplicationPolicy = EInventoryItemsReplicationPolicy::Everyone;
+
+	// Name of the net condition group that subscribers are included in. Unique for each inventory.
+	FName SubscribersNetGroup;
+
+	// Save record that was loaded before the slots were constructed
+	TOptional<FInventorySaveData> PendingSaveData;
+
+	// Players that currently receive the item instances of this inventory
+	TArray<TWeakObjectPtr<APlayerController>> Subscribers;
+
+	// World-wide index of items that is kept up to date with the content of this inventory on the server
+	TWeakObjectPtr<UInventoryItemIndexSubsystem> ItemIndexSubsystem;
+
 	/**
 	* Settings for the number of slots in different types of inventory slots (doesn't work dynamically, value must be
 	* set before BeginPlay).
@@ -90,12 +286,22 @@ private:
 	UPROPERTY(EditDefaultsOnly, Instanced, Replicated)
 	TArray<TObjectPtr<UInventoryManagerFragment>> Fragments;
 
-	// Inventory storage with typed slots containers
-	UPROPERTY(ReplicatedUsing="OnRep_InventoryContent")
+	/**
+	 * Inventory storage with typed slots containers. Replicated as is only if the flat slots replication is disabled
+	 * (see IsFlatSlotsReplicationEnabled).
+	 */
+	UPROPERTY(Replicated)
 	FInventorySlotsTypedArrayContainer InventoryContent;
 
-	UFUNCTION()
-	void OnRep_InventoryContent(FInventorySlotsTypedArrayContainer& Test) const;
+	/**
+	 * The same slots as in InventoryContent but in a single flat fast array. Replicated instead of InventoryContent if
+	 * the flat slots replication is enabled and fills InventoryContent on clients.
+	 */
+	UPROPERTY(Replicated)
+	FInventoryFlatSlotsArray FlatInventoryContent;
+
+	// Only matters on the server, since clients handle both layouts
+	bool bFlatSlotsReplication = false;
 
 #if WITH_EDITORONLY_DATA
 	// If true, then when OnInventoryContentChanged is called, the content of the inventory will be logged
@@ -4,15 +4,20 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "Net/Core/PushModel/PushModel.h"
 #include "Objects/InventoryItemInstance.h"
 #include "InventoryPickupItem.generated.h"
 
+class UInventoryItemIndexSubsystem;
 class UInventoryManagerComponent;
 
+struct FStreamableHandle;
+
 /**
  * Physical representation of inventory item instance in game world (ItemInstance must be set before BeginPlay)
  * - Spawnable pickup actor that holds ItemInstance data.
- * - Automatically updates visual representation (mesh) from item data.
+ * - Automatically updates visual representation (mesh) from item data. The mesh is loaded asynchronously on clients
+ * (the mesh of the CDO is shown until it's loaded) and is never loaded on dedicated servers.
  * - Handles pickup interaction and inventory transfer.
  */
 UCLASS()
@@ -28,7 +33,6 @@ public:
 	UStaticMeshComponent* GetMesh() const { return MeshComponent; }
 
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
-	virtual bool ReplicateSubobjects(class UActorChannel* Channel, class FOutBunch* Bunch, FReplicationFlags* RepFlags) override;
 
 	virtual void OnConstruction(const FTransform& Transform) override;
 
@@ -41,26 +45,41 @@ public:
 #endif
 
 		ItemInstance = InItemInstance;
+		MARK_PROPERTY_DIRTY_FROM_NAME(ThisClass, ItemInstance, this);
 	}
 
-	// Transfers item to inventory and destroys actor
+	// Transfers item to inventory and returns the actor to the pool (or destroys it if there is no pool)
 	void Pickup(UInventoryManagerComponent* InventoryManagerComponent);
 
+	// === Pooling (used by UInventoryPickupItemPoolSubsystem) ===
+
+	bool IsInPool() const { return bInPool; }
+
+	/**
+	 * Brings the pooled actor back to the world: associates it with the new item instance, moves it to the given
+	 * transform, and turns on the visibility, collision, physics, and replication updates.
+	 */
+	void ActivateFromPool(UInventoryItemInstance* InItemInstance, const FTransform& Transform);
+
+	// Hides the actor, turns off its collision and physics, and puts it to the net dormancy until it's activated again
+	void DeactivateToPool();
+
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 	/**
 	 * Applies a change to this actor based on the current item instance (sets mesh as an item instance. But can be
 	 * overriden).
 	 * @return True if all settings are applied correctly.
 	 */
-	virtual bool ApplyChangesFromItemInstance() const;
+	virtual bool ApplyChangesFromItemInstance();
 
 	// Reverts settings to CDO (opposite of ApplyChangesFromItemInstance)
-	virtual void SetDefaultSettings() const;
+	virtual void SetDefaultSettings();
 
 	// Like ApplyChangesFromItemInstance, but at false additionally applies SetDefaultSettings
-	void TryApplyChangesFromItemInstance() const;
+	void TryApplyChangesFromItemInstance();
 
 private:
 	// An item instance this actor is associated with
@@ -73,4 +92,60 @@ private:
 
 	UFUNCTION()
 	void OnRep_ItemInstance();
+
+	TSharedPtr<FStreamableHandle> LoadMeshHandle;
+
+	void CancelMeshLoading();
+	void OnMeshLoaded();
+
+	// Whether the actor is currently waiting in the pool (hidden and without collision)
+	UPROPERTY(ReplicatedUsing="OnRep_InPool")
+	bool bInPool = false;
+
+	UFUNCTION()
+	void OnRep_InPool();
+
+	// Applies the visibility, collision, and physics according to bInPool
+	void ApplyPoolState();
+
+	void RegisterInItemIndex();
+	void UnregisterFromItemIndex();
+
+	// === Rest ===
+
+	/**
+	 * The pickup is considered resting when both its linear (cm/s) and angular (deg/s) speeds are below these
+	 * thresholds during a rest check. Resting pickups put their body to sleep and become net dormant until something
+	 * touches them or a pickup is attempted.
+	 */
+	UPROPERTY(EditDefaultsOnly, Category="Rest")
+	float RestLinearSpeedThreshold = 5;
+
+	UPROPERTY(EditDefaultsOnly, Category="Rest")
+	float RestAngularSpeedThreshold = 10;
+
+	// How often (in seconds) the speeds are checked while the pickup is moving
+	UPROPERTY(EditDefaultsOnly, Category="Rest", meta=(ClampMin=0.01))
+	float RestCheckInterval = 0.5;
+
+	FTimerHandle RestCheckTimerHandle;
+
+	bool bResting = false;
+
+	void StartRestCheck();
+	void CheckRest();
+
+	// Stops the replication of the resting pickup after sending its final transform
+	void EnterRest();
+
+	void WakeFromRest();
+
+	UFUNCTION()
+	void OnMeshSleep(UPrimitiveComponent* SleepingComponent, FName BoneName);
+
+	UFUNCTION()
+	void OnMeshWake(UPrimitiveComponent* WakingComponent, FName BoneName);
+
+	// World-wide index of items this pickup is registered in on the server. Null if the pickup isn't registered.
+	TWeakObjectPtr<UInventoryItemIndexSubsystem> ItemIndexSubsystem;
 };
@@ -0,0 +1,45 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "InventoryCraftingRecipe.generated.h"
+
+class UInventoryItemDefinition;
+
+// Non-mutable data asset that describes which items are consumed to craft an item
+UCLASS(Const)
+class INVENTORYSYSTEM_API UInventoryCraftingRecipe : public UPrimaryDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Fills a recipe that is created at runtime instead of being authored as an asset (e.g., generated recipes).
+	 * @remark Must be called before the recipe is registered in UInventoryCraftingSubsystem.
+	 */
+	void Initialize(const TMap<TSubclassOf<UInventoryItemDefinition>, int32>& InIngredients,
+		const TSubclassOf<UInventoryItemDefinition>& InResultDefinition, const int32 InResultCount = 1);
+
+	const auto& GetIngredients() const { return Ingredients; }
+
+	TSubclassOf<UInventoryItemDefinition> GetResultDefinition() const { return ResultDefinition; }
+	int32 GetResultCount() const { return ResultCount; }
+
+private:
+	/**
+	 * Items that are consumed by crafting.
+	 * @tparam KeyType Definition of the item.
+	 * @tparam ValueType Number of items.
+	 */
+	UPROPERTY(EditDefaultsOnly, meta=(ClampMin=1))
+	TMap<TSubclassOf<UInventoryItemDefinition>, int32> Ingredients;
+
+	UPROPERTY(EditDefaultsOnly)
+	TSubclassOf<UInventoryItemDefinition> ResultDefinition;
+
+	// Number of crafted items. Must not exceed the max stack count of the result item.
+	UPROPERTY(EditDefaultsOnly, meta=(ClampMin=1))
+	int32 ResultCount = 1;
+};
@@ -0,0 +1,26 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "InventoryContentChangeType.generated.h"
+
+// Describes what happened to an inventory slot
+UENUM()
+enum class EInventoryContentChangeType : uint8
+{
+	// An item instance was put into the empty slot
+	Added,
+
+	// The item instance was removed from the slot and the slot is empty now
+	Removed,
+
+	// The item instance in the slot was replaced with another one
+	Replaced,
+
+	// The item instance stayed in the slot, but its stack count was changed (only fired on the server)
+	StackCountChanged,
+
+	// The item instance stayed in the slot, but one of its other stats was changed (only fired on the server)
+	StatChanged
+};
@@ -0,0 +1,20 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "InventoryItemsReplicationPolicy.generated.h"
+
+// Determines which connections receive the item instances of an inventory
+UENUM()
+enum class EInventoryItemsReplicationPolicy : uint8
+{
+	// Item instances are replicated to every connection
+	Everyone,
+
+	// Item instances are replicated only to the owner of the inventory (e.g., personal inventories of characters)
+	OwnerOnly,
+
+	// Item instances are replicated only to the players that opened the inventory (e.g., desks, cabinets, etc.)
+	Subscribers
+};
@@ -0,0 +1,105 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "InventorySlotsTypedArrayContainer.h"
+#include "Net/Serialization/FastArraySerializer.h"
+#include "InventoryFlatSlotsArray.generated.h"
+
+class UInventoryItemInstance;
+class UInventoryManagerComponent;
+
+struct FInventoryFlatSlotsArray;
+
+// A single slot of any type in the flat replication layout of an inventory
+USTRUCT()
+struct FInventoryFlatSlot : public FFastArraySerializerItem
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FGameplayTag TypeTag;
+
+	UPROPERTY()
+	int32 SlotIndex = 0;
+
+	UPROPERTY()
+	TObjectPtr<UInventoryItemInstance> Instance = nullptr;
+
+	// === Client-side application of the replicated slot to the inventory content ===
+
+	void PostReplicatedAdd(const FInventoryFlatSlotsArray& InArraySerializer);
+	void PostReplicatedChange(const FInventoryFlatSlotsArray& InArraySerializer);
+
+private:
+	void ApplyToInventory(const FInventoryFlatSlotsArray& InArraySerializer) const;
+};
+
+/**
+ * Single-level replication layout of the inventory content. Every slot of every type is a separate item keyed by its
+ * type tag and index, so a slot change is replicated as exactly one item delta instead of the whole nested slots array
+ * of FInventorySlotsTypedArrayContainer. Mirrors the container on the server, and fills it on clients.
+ */
+USTRUCT()
+struct FInventoryFlatSlotsArray : public FFastArraySerializer
+{
+	GENERATED_BODY()
+
+	UInventoryManagerComponent* GetOwner() const { return Owner; }
+
+	// Sets the inventory whose content is filled with the replicated slots
+	void SetOwner(UInventoryManagerComponent* InOwner) { Owner = InOwner; }
+
+	// Creates an empty item for every slot of the container in the same order
+	void Construct(const FInventorySlotsTypedArrayContainer& Container)
+	{
+		Slots.Reset();
+		FirstSlotIndices.Reset(Container.GetItems().Num());
+
+		for (const FInventorySlotsTypedArray& TypedArray : Container.GetItems())
+		{
+			FirstSlotIndices.Add(Slots.Num());
+
+			for (int32 SlotIndex = 0; SlotIndex < TypedArray.Array.GetItems().Num(); ++SlotIndex)
+			{
+				FInventoryFlatSlot& Slot = Slots.AddDefaulted_GetRef();
+				Slot.TypeTag = TypedArray.TypeTag;
+				Slot.SlotIndex = SlotIndex;
+			}
+		}
+
+		MarkArrayDirty();
+	}
+
+	// Takes the same indices as FInventorySlotsTypedArrayContainer::SetInstance
+	void SetInstance(UInventoryItemInstance* Instance, const int32 ArrayIndex, const int32 SlotIndex)
+	{
+		FInventoryFlatSlot& Slot = Slots[FirstSlotIndices[ArrayIndex] + SlotIndex];
+
+		Slot.Instance = Instance;
+		MarkItemDirty(Slot);
+	}
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParams)
+	{
+		return FastArrayDeltaSerialize<FInventoryFlatSlot, FInventoryFlatSlotsArray>(Slots, DeltaParams, *this);
+	}
+
+private:
+	UPROPERTY()
+	TArray<FInventoryFlatSlot> Slots;
+
+	// Index of the first flat slot of each slots array of the container. Filled only on the server.
+	TArray<int32> FirstSlotIndices;
+
+	UInventoryManagerComponent* Owner = nullptr;
+};
+
+template<>
+struct TStructOpsTypeTraits<FInventoryFlatSlotsArray> : TStructOpsTypeTraitsBase2<FInventoryFlatSlotsArray>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true,
+	};
+};
@@ -42,6 +42,24 @@ struct FInventorySlotsArray : public FFastArraySerializer
 		MarkItemDirty(Slots[Index]);
 	}
 
+	/**
+	 * Sets the instance received by another replication layout without marking the slot dirty (client only). The
+	 * slots are added if there are not enough of them.
+	 * @return The previous item instance of the slot.
+	 */
+	UInventoryItemInstance* SetReplicatedInstance(UInventoryItemInstance* Instance, const int32 Index)
+	{
+		if (Slots.Num() <= Index)
+		{
+			Slots.SetNum(Index + 1);
+		}
+
+		UInventoryItemInstance* OldInstance = Slots[Index].Instance;
+		Slots[Index].Instance = Instance;
+
+		return OldInstance;
+	}
+
 	/**
 	 * Finds first available empty slot in inventory
 	 * @return Index of first empty slot, or INDEX_NONE if all slots are occupied
@@ -7,8 +7,10 @@
 #include "InventorySlotsTypedArrayContainer.generated.h"
 
 class UInventoryItemInstance;
+class UInventoryManagerComponent;
 
 struct FInventorySlotsArray;
+struct FInventorySlotsTypedArrayContainer;
 
 // Typifies an array of slots with tag
 USTRUCT()
@@ -31,6 +33,33 @@ struct FInventorySlotsTypedArray : public FFastArraySerializerItem
 	{
 		return TypeTag == Other.TypeTag;
 	}
+
+	// === Client-side notifications about the changed slots ===
+
+	void PostReplicatedAdd(const FInventorySlotsTypedArrayContainer& InArraySerializer);
+	void PostReplicatedChange(const FInventorySlotsTypedArrayContainer& InArraySerializer);
+
+private:
+	// State of a slot from the previous replication
+	struct FReplicatedSlot
+	{
+		TWeakObjectPtr<UInventoryItemInstance> Instance;
+
+		/**
+		 * Whether the slot had an item. Stored separately because the weak pointer becomes null when the old instance
+		 * is garbage collected before the change is replicated, which would turn a replacement into an addition.
+		 */
+		bool bOccupied = false;
+	};
+
+	/**
+	 * Slots from the previous replication. The nested slots array is replicated as a whole with the typed array, so the
+	 * changed slots are found by comparing with this copy.
+	 */
+	TArray<FReplicatedSlot> ReplicatedSlots;
+
+	// Broadcasts a change for each slot whose item instance differs from the previous replication
+	void BroadcastReplicatedChanges(const FInventorySlotsTypedArrayContainer& InArraySerializer);
 };
 
 // Contain arrays of slots by their types
@@ -39,6 +68,11 @@ struct FInventorySlotsTypedArrayContainer : public FFastArraySerializer
 {
 	GENERATED_BODY()
 
+	UInventoryManagerComponent* GetOwner() const { return Owner; }
+
+	// Sets the inventory that is notified about the replicated changes
+	void SetOwner(UInventoryManagerComponent* InOwner) { Owner = InOwner; }
+
 	/**
 	 * Initializes inventory slots from configuration data.
 	 * @tparam KeyType Tag of the slot's type.
@@ -75,6 +109,25 @@ struct FInventorySlotsTypedArrayContainer : public FFastArraySerializer
 		MarkItemDirty(Arrays[ArrayIndex]);
 	}
 
+	/**
+	 * Sets the instance received by another replication layout without marking the arrays dirty (client only). The
+	 * slots array of the given type and the slot are added if they don't exist yet.
+	 * @return The previous item instance of the slot.
+	 */
+	UInventoryItemInstance* SetReplicatedInstance(UInventoryItemInstance* Instance, const FGameplayTag& TypeTag,
+		const int32 SlotIndex)
+	{
+		int32 ArrayIndex = IndexOfByTag(TypeTag);
+
+		if (ArrayIndex == INDEX_NONE)
+		{
+			ArrayIndex = Arrays.AddDefaulted();
+			Arrays[ArrayIndex].TypeTag = TypeTag;
+		}
+
+		return Arrays[ArrayIndex].Array.SetReplicatedInstance(Instance, SlotIndex);
+	}
+
 	int32 IndexOfByTag(const FGameplayTag& TypeTag) const
 	{
 		return Arrays.IndexOfByPredicate([TypeTag](const FInventorySlotsTypedArray& List)
@@ -93,6 +146,8 @@ private:
 	// Arrays of slots by their types
 	UPROPERTY()
 	TArray<FInventorySlotsTypedArray> Arrays;
+
+	UInventoryManagerComponent* Owner = nullptr;
 };
 
 template<>
@@ -0,0 +1,64 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "Common/Enums/InventoryContentChangeType.h"
+
+class UInventoryItemInstance;
+
+// Describes a change of a single inventory slot
+struct FInventoryContentChange
+{
+	FInventoryContentChange(const FGameplayTag& InSlotTypeTag, const int32 InSlotIndex,
+		UInventoryItemInstance* InOldInstance, UInventoryItemInstance* InNewInstance)
+		: SlotTypeTag(InSlotTypeTag)
+		, SlotIndex(InSlotIndex)
+		, OldInstance(InOldInstance)
+		, NewInstance(InNewInstance)
+	{
+		if (OldInstance == NewInstance)
+		{
+			ChangeType = EInventoryContentChangeType::StackCountChanged;
+		}
+		else if (!OldInstance)
+		{
+			ChangeType = EInventoryContentChangeType::Added;
+		}
+		else if (!NewInstance)
+		{
+			ChangeType = EInventoryContentChangeType::Removed;
+		}
+		else
+		{
+			ChangeType = EInventoryContentChangeType::Replaced;
+		}
+	}
+
+	// Used when the type can't be deduced from the instances (e.g., the old instance is already garbage collected)
+	FInventoryContentChange(const FGameplayTag& InSlotTypeTag, const int32 InSlotIndex,
+		UInventoryItemInstance* InOldInstance, UInventoryItemInstance* InNewInstance,
+		const EInventoryContentChangeType InChangeType)
+		: SlotTypeTag(InSlotTypeTag)
+		, SlotIndex(InSlotIndex)
+		, OldInstance(InOldInstance)
+		, NewInstance(InNewInstance)
+		, ChangeType(InChangeType)
+	{
+	}
+
+	FGameplayTag SlotTypeTag;
+	int32 SlotIndex;
+
+	/**
+	 * Item instance that was in the slot before the change. Could be already pending kill on clients, or even null if
+	 * it was garbage collected before the change was replicated.
+	 */
+	UInventoryItemInstance* OldInstance;
+
+	// Item instance that is in the slot after the change
+	UInventoryItemInstance* NewInstance;
+
+	EInventoryContentChangeType ChangeType;
+};
@@ -0,0 +1,79 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "InventorySaveData.generated.h"
+
+class UInventoryItemDefinition;
+
+// Stat of a saved item that differs from the default value of its definition
+USTRUCT()
+struct FInventoryItemStatSaveData
+{
+	GENERATED_BODY()
+
+	// Index of the stat tag in FInventorySaveData::StatTags (so a save supports up to 256 different stat tags)
+	UPROPERTY(SaveGame)
+	uint8 TagIndex = 0;
+
+	UPROPERTY(SaveGame)
+	float Value = 0;
+};
+
+// Item saved in a single inventory slot
+USTRUCT()
+struct FInventorySlotSaveData
+{
+	GENERATED_BODY()
+
+	// Index of the item definition in FInventorySaveData::Definitions (up to 65536 different definitions)
+	UPROPERTY(SaveGame)
+	uint16 DefinitionIndex = 0;
+
+	// Index of the slot type tag in FInventorySaveData::SlotTypeTags (up to 256 slot types)
+	UPROPERTY(SaveGame)
+	uint8 SlotTypeIndex = 0;
+
+	// Up to 65536 slots of each type
+	UPROPERTY(SaveGame)
+	uint16 SlotIndex = 0;
+
+	// Only the stats that differ from the stats of a newly initialized item of the same definition
+	UPROPERTY(SaveGame)
+	TArray<FInventoryItemStatSaveData> ChangedStats;
+};
+
+/**
+ * Compact save record of an inventory content. Definition paths and tags are stored once per save in the tables, and
+ * the slots reference them by indices.
+ */
+USTRUCT()
+struct FInventorySaveData
+{
+	GENERATED_BODY()
+
+	UPROPERTY(SaveGame)
+	TArray<TSoftClassPtr<UInventoryItemDefinition>> Definitions;
+
+	UPROPERTY(SaveGame)
+	TArray<FGameplayTag> SlotTypeTags;
+
+	UPROPERTY(SaveGame)
+	TArray<FGameplayTag> StatTags;
+
+	// Occupied slots only
+	UPROPERTY(SaveGame)
+	TArray<FInventorySlotSaveData> Slots;
+
+	bool IsEmpty() const { return Slots.IsEmpty(); }
+
+	void Reset()
+	{
+		Definitions.Reset();
+		SlotTypeTags.Reset();
+		StatTags.Reset();
+		Slots.Reset();
+	}
+};
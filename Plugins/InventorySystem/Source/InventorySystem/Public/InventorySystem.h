@@ -6,6 +6,8 @@
 
 DECLARE_LOG_CATEGORY_EXTERN(LogInventorySystem, Log, All);
 
+DECLARE_STATS_GROUP(TEXT("Inventory"), STATGROUP_Inventory, STATCAT_Advanced);
+
 class FInventorySystemModule : public IModuleInterface
 {
 public:
@@ -8,4 +8,7 @@ namespace InventorySystemGameplayTags
 {
 	// SlotTypes
 	UE_DECLARE_GAMEPLAY_TAG_EXTERN(Inventory_Slot_Type_Main);
+
+	// InstanceStats
+	UE_DECLARE_GAMEPLAY_TAG_EXTERN(Inventory_Item_Stat_StackCount);
 }
@@ -3,6 +3,8 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "Common/Structs/FastArraySerializers/InstanceStats.h"
 #include "InventoryItemDefinition.generated.h"
 
 class UInventoryItemFragment;
@@ -18,10 +20,28 @@ public:
 
 	const TArray<UInventoryItemFragment*>& GetFragments() const { return Fragments; }
 
+	const FGameplayTagContainer& GetTags() const { return Tags; }
+
+	/**
+	 * Returns the stats of a newly initialized item of this definition. They are gathered once on the first call.
+	 * @remark Must be called on the class default object.
+	 */
+	const TArray<FInstanceStatsItem>& GetDefaultInstanceStats() const;
+
+	// Returns the maximum number of items that can be stored in an item of this definition (1 if it isn't stackable)
+	int32 GetMaxStackCount() const;
+
 private:
 	UPROPERTY(EditDefaultsOnly)
 	FText DisplayName;
 
+	// Tags that describe the item for gameplay queries (e.g., whether the item is a contraband)
+	UPROPERTY(EditDefaultsOnly)
+	FGameplayTagContainer Tags;
+
 	UPROPERTY(EditDefaultsOnly, Instanced)
 	TArray<TObjectPtr<UInventoryItemFragment>> Fragments;
+
+	mutable TArray<FInstanceStatsItem> DefaultInstanceStats;
+	mutable bool bDefaultInstanceStatsGathered = false;
 };
@@ -6,16 +6,19 @@
 #include "Objects/InventoryItemFragment.h"
 #include "PickupInventoryItemFragment.generated.h"
 
-// Adds a visual representation of the object on the scene
+/**
+ * Adds a visual representation of the object on the scene. The mesh is a soft reference, so it's loaded only by the
+ * pickups that are actually rendered (never on dedicated servers).
+ */
 UCLASS()
 class INVENTORYSYSTEM_API UPickupInventoryItemFragment : public UInventoryItemFragment
 {
 	GENERATED_BODY()
 
 public:
-	UStaticMesh* GetMesh() const { return StaticMesh; }
+	const TSoftObjectPtr<UStaticMesh>& GetMesh() const { return StaticMesh; }
 
 private:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta=(AllowPrivateAccess="true"))
-	TObjectPtr<UStaticMesh> StaticMesh;
+	TSoftObjectPtr<UStaticMesh> StaticMesh;
 };
@@ -0,0 +1,27 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Objects/InventoryItemFragment.h"
+#include "StackableInventoryItemFragment.generated.h"
+
+/**
+ * Allows multiple items of the same definition to be stored in a single item instance (and therefore in a single slot).
+ * The number of items is stored in the Inventory.Item.Stat.StackCount instance stat.
+ */
+UCLASS()
+class INVENTORYSYSTEM_API UStackableInventoryItemFragment : public UInventoryItemFragment
+{
+	GENERATED_BODY()
+
+public:
+	int32 GetMaxStackCount() const { return MaxStackCount; }
+
+	virtual void OnItemInstanceInitialized(UInventoryItemInstance* Instance) override;
+
+private:
+	// Maximum number of items that can be stored in a single slot
+	UPROPERTY(EditDefaultsOnly, meta=(ClampMin=1, UIMin=1))
+	int32 MaxStackCount = 20;
+};
@@ -9,6 +9,8 @@
 
 class UInventoryItemDefinition;
 class UInventoryItemFragment;
+class UInventoryManagerComponent;
+class UStackableInventoryItemFragment;
 
 /**
  * Represents a runtime instance of an inventory item that can be replicated across the network.
@@ -26,6 +28,12 @@ class INVENTORYSYSTEM_API UInventoryItemInstance : public UObject
 {
 	GENERATED_BODY()
 
+	// The stats of the items in an inventory are changed only by the inventory, so it can keep its item index in sync
+	friend UInventoryManagerComponent;
+
+	// Sets the initial stack count of the new items
+	friend UStackableInventoryItemFragment;
+
 public:
 	virtual bool IsSupportedForNetworking() const override { return true; }
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
@@ -37,8 +45,38 @@ public:
 	 */
 	void Initialize(const TSubclassOf<UInventoryItemDefinition>& InDefinition = nullptr);
 
+	/**
+	 * Initializes a new item with the given number of items stored in it. Used to create the items that are going to
+	 * be added to an inventory.
+	 * @remark The stack count must be 1 for the items without UStackableInventoryItemFragment.
+	 */
+	void Initialize(const TSubclassOf<UInventoryItemDefinition>& InDefinition, const int32 InStackCount);
+
 	TSubclassOf<UInventoryItemDefinition> GetDefinition() const { return Definition; }
 
+	const FInstanceStats& GetInstanceStats() const { return InstanceStats; }
+
+	// Returns the number of items stored in this instance (always 1 for items without UStackableInventoryItemFragment)
+	int32 GetStackCount() const;
+
+	// Returns the maximum number of items that can be stored in this instance (1 if the item isn't stackable)
+	int32 GetMaxStackCount() const;
+
+	bool IsStackable() const { return GetMaxStackCount() > 1; }
+
+	/**
+	 * Checks whether the given item instance can be merged into this one: both instances must be stackable, have the
+	 * same definition and have equal stats (except for the stack count).
+	 */
+	bool CanStackWith(const UInventoryItemInstance* Other) const;
+
+	/**
+	 * Checks whether an item of the given definition with the given stats can be merged into this one. Allows checking
+	 * it without creating the other item (e.g., with the default stats of the definition).
+	 */
+	bool CanStackWith(const TSubclassOf<UInventoryItemDefinition>& OtherDefinition,
+		const TArray<FInstanceStatsItem>& OtherStats) const;
+
 	// Gathers all fragments of the specified class type and writes them into the provided array.
 	template<typename T>
 	T* GetFragmentByClass() const;
@@ -54,11 +92,32 @@ public:
 	UInventoryItemInstance* Duplicate(UObject* Outer) const;
 
 private:
-	// Determines what the item can do (сan be thrown away, is a tool, key, etc.)
+	/**
+	 * Adds a new stat or rewrites the value of the existing one.
+	 * @remark Use UInventoryManagerComponent::SetItemInstanceStat to change the stats of an item in an inventory.
+	 */
+	void SetInstanceStat(const FInstanceStatsItem& InStat);
+
+	// Try to avoid calling this method as deleting a stat completely leads to replication of all stats
+	void RemoveInstanceStat(const FGameplayTag& InTag);
+
+	/**
+	 * Sets the number of items stored in this instance.
+	 * @remark Should only be called for items with UStackableInventoryItemFragment.
+	 */
+	void SetStackCount(const int32 NewStackCount);
+
+	/**
+	 * Determines what the item can do (сan be thrown away, is a tool, key, etc.)
+	 * @remark Replicated with the push model, so it must be marked dirty whenever it's changed.
+	 */
 	UPROPERTY(EditAnywhere, Replicated)
 	TSubclassOf<UInventoryItemDefinition> Definition;
 
-	// Stores per-instance data specific to this item, populated by its definition's fragments
+	/**
+	 * Stores per-instance data specific to this item, populated by its definition's fragments.
+	 * @remark Replicated with the push model, so it must be changed only via SetInstanceStat and RemoveInstanceStat.
+	 */
 	UPROPERTY(EditAnywhere, Replicated)
 	FInstanceStats InstanceStats;
 
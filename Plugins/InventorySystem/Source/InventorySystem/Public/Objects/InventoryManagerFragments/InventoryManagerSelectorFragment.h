@@ -9,7 +9,36 @@
 
 class AInventoryPickupItem;
 
-// Stores the slot selector in the inventory array and allows to offset it
+/**
+ * Slot index that was accepted by the server along with the sequence number of the client change it responds to, or of
+ * the change made by the server itself.
+ */
+USTRUCT()
+struct FInventoryAcceptedSelection
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	int32 SlotIndex = 0;
+
+	UPROPERTY()
+	uint16 Sequence = 0;
+
+	/**
+	 * Whether the selection was changed by the server rather than requested by the client. The sequence number is
+	 * bumped by the server in this case, and the owner always applies the selection.
+	 */
+	UPROPERTY()
+	bool bServerOriginated = false;
+};
+
+/**
+ * Stores the slot selector in the inventory array and allows to offset it. The selection is predicted by the owning
+ * client: changes are applied locally right away, and all changes made within SendDelay are sent to the server as a
+ * single unreliable absolute index with a sequence number. The server replicates the accepted selection back to the
+ * owner, which corrects the prediction only if the server disagrees. Changes made by the server itself are sent to the
+ * owner the same way, with a sequence number bumped by the server.
+ */
 UCLASS()
 class INVENTORYSYSTEM_API UInventoryManagerSelectorFragment : public UInventoryManagerFragment
 {
@@ -23,9 +52,11 @@ public:
 	const FGameplayTag& GetSelectableSlotsTypeTag() const { return SelectableSlotsTypeTag; }
 	int32 GetCurrentSlotIndex() const { return CurrentSlotIndex; }
 
-	// Offsets CurrentSlotIndex to the passed value within the inventory
-	UFUNCTION(Server, Reliable)
-	void Server_OffsetCurrentSlotIndex(const int32 Offset);
+	/**
+	 * Offsets CurrentSlotIndex to the passed value within the inventory. Applied immediately on the server and on the
+	 * owning client (the client then sends the result to the server).
+	 */
+	void OffsetCurrentSlotIndex(const int32 Offset);
 
 	DECLARE_MULTICAST_DELEGATE_OneParam(FOnOffsetCurrentSlotIndexDelegate, int32 CurrentSlotIndex);
 
@@ -42,13 +73,53 @@ private:
 	UPROPERTY(EditDefaultsOnly)
 	FGameplayTag SelectableSlotsTypeTag = InventorySystemGameplayTags::Inventory_Slot_Type_Main;
 
-	// Index of the currently selected slot
+	/**
+	 * Index of the currently selected slot. Replicated to everyone except the owner, who predicts it and receives
+	 * AcceptedSelection instead.
+	 */
 	UPROPERTY(Transient, ReplicatedUsing="OnRep_SelectedSlotIndex")
 	int32 CurrentSlotIndex;
 
 	UFUNCTION()
 	void OnRep_SelectedSlotIndex();
 
+	// Sets the CurrentSlotIndex and notifies about it if it changed
+	void SetCurrentSlotIndex(const int32 NewSlotIndex);
+
+	// Returns the number of slots of the SelectableSlotsTypeTag type or 0 if there are no such slots
+	int32 GetSlotsNumber() const;
+
+	// === Prediction ===
+
+	// Time in seconds during which the selection changes on the owning client are coalesced into a single update
+	UPROPERTY(EditDefaultsOnly, Category="Prediction", meta=(ClampMin=0))
+	float SendDelay = 0.1;
+
+	// Time in seconds after which the update is sent again if the server hasn't accepted it yet (unreliable RPC)
+	UPROPERTY(EditDefaultsOnly, Category="Prediction", meta=(ClampMin=0.01))
+	float ResendInterval = 0.5;
+
+	// The last selection accepted by the server. Replicated only to the owner to confirm or correct its prediction.
+	UPROPERTY(Transient, ReplicatedUsing="OnRep_AcceptedSelection")
+	FInventoryAcceptedSelection AcceptedSelection;
+
+	UFUNCTION()
+	void OnRep_AcceptedSelection();
+
+	// Sequence number of the last selection change predicted by the owning client
+	uint16 PredictedSequence = 0;
+
+	FTimerHandle SendTimerHandle;
+
+	// Schedules sending the predicted selection to the server within SendDelay
+	void ScheduleSend();
+
+	// Sends the predicted selection to the server unless it's already accepted
+	void SendPredictedSelection();
+
+	UFUNCTION(Server, Unreliable)
+	void Server_SetCurrentSlotIndex(const int32 SlotIndex, const uint16 Sequence);
+
 #if WITH_EDITORONLY_DATA
 	// Whether to log the CurrentSlotIndex when it changes
 	UPROPERTY(EditDefaultsOnly)
@@ -0,0 +1,110 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "InventoryCraftingSubsystem.generated.h"
+
+class UInventoryCraftingRecipe;
+class UInventoryItemDefinition;
+class UInventoryItemInstance;
+class UInventoryManagerComponent;
+
+/**
+ * Indexes crafting recipes, so matching items against the recipes doesn't require checking every recipe:
+ * - Each recipe is keyed by a canonical hash of its ingredients multiset (the hash doesn't depend on the order of the
+ * ingredients), so finding the recipe for exactly the given items is a hash lookup.
+ * - Each ingredient keeps the list of recipes that use it, so "what can be crafted now" only visits the recipes that
+ * use the items which are actually available.
+ */
+UCLASS(Config=Game)
+class INVENTORYSYSTEM_API UInventoryCraftingSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	// Adds the recipe to the index. Recipes with invalid ingredients or result are ignored.
+	void RegisterRecipe(const UInventoryCraftingRecipe* Recipe);
+
+	// Removes all recipes from the index
+	void ResetRecipes();
+
+	int32 GetRecipesNumber() const { return IndexedRecipes.Num(); }
+
+	/**
+	 * Finds the recipe whose ingredients are exactly the given items.
+	 * @param Items Number of items by their definitions.
+	 * @return The recipe or nullptr if there is no such recipe.
+	 */
+	const UInventoryCraftingRecipe* FindRecipeByIngredients(
+		const TMap<TSubclassOf<UInventoryItemDefinition>, int32>& Items) const;
+
+	/**
+	 * Gathers all recipes that can be crafted from the given items.
+	 * @param Items Number of available items by their definitions.
+	 * @param OutRecipes Recipes whose ingredients are all available in the required numbers.
+	 */
+	void GetCraftableRecipes(const TMap<TSubclassOf<UInventoryItemDefinition>, int32>& Items,
+		TArray<const UInventoryCraftingRecipe*>& OutRecipes) const;
+
+	// Gathers all recipes that can be crafted from the items in the given inventory
+	void GetCraftableRecipes(const UInventoryManagerComponent* Inventory,
+		TArray<const UInventoryCraftingRecipe*>& OutRecipes) const;
+
+	/**
+	 * Consumes the ingredients of the recipe from the inventory and adds the result to it. Results above the max stack
+	 * count are split into several stacks. Nothing is changed if there are not enough ingredients or there is no space
+	 * for the whole result. Must be called on the server.
+	 * @return True if the item was crafted.
+	 */
+	bool Craft(UInventoryManagerComponent* Inventory, const UInventoryCraftingRecipe* Recipe) const;
+
+	// Returns the hash of the given items multiset that doesn't depend on the order of the items
+	static uint32 GetIngredientsHash(const TMap<TSubclassOf<UInventoryItemDefinition>, int32>& Items);
+
+private:
+	// Recipes that are registered when the subsystem is initialized
+	UPROPERTY(Config)
+	TArray<TSoftObjectPtr<UInventoryCraftingRecipe>> DefaultRecipes;
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<const UInventoryCraftingRecipe>> IndexedRecipes;
+
+	// Indices of the recipes in IndexedRecipes by the hashes of their ingredients
+	TMultiMap<uint32, int32> RecipeIndicesByHash;
+
+	// Recipe that uses an ingredient and the number of items of this ingredient it requires
+	struct FIngredientUsage
+	{
+		int32 RecipeIndex;
+		int32 Count;
+	};
+
+	TMap<TSubclassOf<UInventoryItemDefinition>, TArray<FIngredientUsage>> UsagesByIngredient;
+
+	// Number of items to consume from a slot of the inventory
+	struct FConsumedSlot
+	{
+		FGameplayTag TypeTag;
+		int32 SlotIndex;
+		int32 Count;
+	};
+
+	/**
+	 * Finds the slots to consume the given number of items of the given definition from without changing anything
+	 * @return False if there are not enough items
+	 */
+	static bool PlanConsumption(const UInventoryManagerComponent* Inventory,
+		const TSubclassOf<UInventoryItemDefinition>& Definition, int32 Count, TArray<FConsumedSlot>& OutPlan);
+
+	/**
+	 * Returns how many new items of the given definition would fit into the slots the result of a recipe is added to
+	 * after the planned consumption, including the slots the consumption empties
+	 */
+	static int32 GetFreeSpaceAfterConsumption(const UInventoryManagerComponent* Inventory,
+		const TSubclassOf<UInventoryItemDefinition>& Definition, const TArray<FConsumedSlot>& Plan);
+};
@@ -0,0 +1,85 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "UObject/ObjectKey.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "InventoryItemIndexSubsystem.generated.h"
+
+class UInventoryItemDefinition;
+
+/**
+ * Keeps track of which objects hold which items in the world, so questions like "does this player carry contraband" or
+ * "where are all items of definition X" can be answered without walking every inventory and every slot. Holders are
+ * inventories (UInventoryManagerComponent) and pickups (AInventoryPickupItem) that update the index incrementally when
+ * their content changes on the server. Items are indexed by their definition and by all tags of the definition
+ * (including the parent tags).
+ */
+UCLASS()
+class INVENTORYSYSTEM_API UInventoryItemIndexSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// Registers the given number of items of the given definition as held by the given holder
+	void AddItems(const UObject* Holder, const TSubclassOf<UInventoryItemDefinition>& Definition, const int32 Count);
+
+	// Unregisters the given number of items of the given definition from the given holder
+	void RemoveItems(const UObject* Holder, const TSubclassOf<UInventoryItemDefinition>& Definition,
+		const int32 Count);
+
+	// Returns the number of items of the given definition in the whole world
+	int32 GetItemsCount(const TSubclassOf<UInventoryItemDefinition>& Definition) const;
+
+	// Returns the number of items with the given tag in the whole world
+	int32 GetItemsCountByTag(const FGameplayTag& Tag) const;
+
+	// Returns the number of items of the given definition held by the given holder
+	int32 GetHolderItemsCount(const UObject* Holder, const TSubclassOf<UInventoryItemDefinition>& Definition) const;
+
+	// Returns the number of items with the given tag held by the given holder
+	int32 GetHolderItemsCountByTag(const UObject* Holder, const FGameplayTag& Tag) const;
+
+	bool HasItemWithTag(const UObject* Holder, const FGameplayTag& Tag) const
+	{
+		return GetHolderItemsCountByTag(Holder, Tag) > 0;
+	}
+
+	// Gathers all holders of the items of the given definition
+	void GetHolders(const TSubclassOf<UInventoryItemDefinition>& Definition, TArray<UObject*>& OutHolders) const;
+
+	// Gathers all holders of the items with the given tag
+	void GetHoldersByTag(const FGameplayTag& Tag, TArray<UObject*>& OutHolders) const;
+
+	// Gathers all definitions that have at least one item in the world
+	void GetIndexedDefinitions(TArray<TSubclassOf<UInventoryItemDefinition>>& OutDefinitions) const
+	{
+		CountersByDefinition.GetKeys(OutDefinitions);
+	}
+
+private:
+	// Number of items of a single definition or tag in the world and per holder
+	struct FItemsCounter
+	{
+		int32 TotalCount = 0;
+
+		TMap<TObjectKey<UObject>, int32> CountByHolder;
+
+		void Add(const TObjectKey<UObject>& HolderKey, const int32 Count);
+
+		// @return True if the counter became empty
+		bool Remove(const TObjectKey<UObject>& HolderKey, const int32 Count);
+
+		void GetHolders(TArray<UObject*>& OutHolders) const;
+	};
+
+	TMap<TSubclassOf<UInventoryItemDefinition>, FItemsCounter> CountersByDefinition;
+	TMap<FGameplayTag, FItemsCounter> CountersByTag;
+
+	// Tags of the definitions including the parent tags
+	TMap<TSubclassOf<UInventoryItemDefinition>, FGameplayTagContainer> IndexedTagsByDefinition;
+
+	const FGameplayTagContainer& GetIndexedTags(const TSubclassOf<UInventoryItemDefinition>& Definition);
+};
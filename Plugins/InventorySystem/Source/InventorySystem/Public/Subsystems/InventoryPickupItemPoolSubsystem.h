@@ -0,0 +1,77 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "InventoryPickupItemPoolSubsystem.generated.h"
+
+class AInventoryPickupItem;
+class UInventoryItemInstance;
+
+USTRUCT()
+struct FInventoryPickupItemsPool
+{
+	GENERATED_BODY()
+
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<AInventoryPickupItem>> PickupItems;
+};
+
+/**
+ * Reuses pickup actors instead of spawning a new one for every dropped item and destroying it when it's picked up.
+ * Released pickups are hidden, their collision and physics are turned off, and they are put to the net dormancy until
+ * they are acquired again. Pools are separate for each pickup class. Must be used only on the server.
+ */
+UCLASS(Config=Game)
+class INVENTORYSYSTEM_API UInventoryPickupItemPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	/**
+	 * Returns a pickup of the given class placed at the given transform and associated with a duplicate of the given item
+	 * instance. A pooled pickup is reused if there is one, otherwise a new one is spawned.
+	 */
+	AInventoryPickupItem* AcquirePickupItem(const TSubclassOf<AInventoryPickupItem>& PickupItemClass,
+		const UInventoryItemInstance* ItemInstance, const FTransform& Transform);
+
+	// Returns the pickup to the pool or destroys it if the pool of its class is full
+	void ReleasePickupItem(AInventoryPickupItem* PickupItem);
+
+	// Returns the number of pickups of the given class that are waiting in the pool
+	int32 GetPoolSize(const TSubclassOf<AInventoryPickupItem>& PickupItemClass) const;
+
+	// Number of acquisitions that reused a pooled pickup
+	int32 GetHitsNumber() const { return HitsNumber; }
+
+	// Number of acquisitions that had to spawn a new pickup
+	int32 GetMissesNumber() const { return MissesNumber; }
+
+	// Returns the fraction of acquisitions that reused a pooled pickup
+	float GetHitRate() const;
+
+	// Prints the sizes of all pools and the hit rate to the log
+	void LogPoolsState() const;
+
+private:
+	// Maximum number of pickups of a single class that can wait in the pool. The others are destroyed when released.
+	UPROPERTY(Config)
+	int32 MaxPoolSizePerClass = 32;
+
+	UPROPERTY(Transient)
+	TMap<TSubclassOf<AInventoryPickupItem>, FInventoryPickupItemsPool> Pools;
+
+	int32 PooledPickupItemsNumber = 0;
+
+	int32 HitsNumber = 0;
+	int32 MissesNumber = 0;
+
+	// Takes the last valid pickup from the pool of the given class. Pickups could be destroyed while they were pooled.
+	AInventoryPickupItem* PopPickupItem(const TSubclassOf<AInventoryPickupItem>& PickupItemClass);
+
+	AInventoryPickupItem* SpawnPickupItem(const TSubclassOf<AInventoryPickupItem>& PickupItemClass,
+		const UInventoryItemInstance* ItemInstance, const FTransform& Transform) const;
+};
@@ -0,0 +1,108 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "InventorySystemGameplayTags.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "InventoryRestockSubsystem.generated.h"
+
+class UInventoryItemDefinition;
+class UInventoryItemInstance;
+class UInventoryManagerComponent;
+
+// Describes how many items of which definition must be added to an inventory
+USTRUCT()
+struct FInventoryRestockJob
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TWeakObjectPtr<UInventoryManagerComponent> Inventory;
+
+	UPROPERTY()
+	TSubclassOf<UInventoryItemDefinition> Definition;
+
+	// Number of items to add. Stackable items are added by stacks, others one by one.
+	UPROPERTY()
+	int32 Count = 1;
+
+	UPROPERTY()
+	FGameplayTag SlotTypeTag = InventorySystemGameplayTags::Inventory_Slot_Type_Main;
+};
+
+// Item created in advance for a part of a restock job (a full stack for stackable items or a single item for others)
+USTRUCT()
+struct FInventoryRestockPortion
+{
+	GENERATED_BODY()
+
+	// Created with the inventory of the job as the Outer, so it's put into the slot as it is
+	UPROPERTY()
+	TObjectPtr<UInventoryItemInstance> ItemInstance;
+
+	// Index of the job in the pending jobs of the restock
+	int32 JobIndex = 0;
+};
+
+/**
+ * Fills inventories with items in bulk (e.g., when desks and containers are restocked at the start of a game day)
+ * without hitches. All item instances are created when jobs are enqueued, and they are put into the inventories over
+ * multiple frames within FrameBudgetMilliseconds per frame, so the ticks don't create any objects.
+ */
+UCLASS(Config=Game)
+class INVENTORYSYSTEM_API UInventoryRestockSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+
+	// Adds the jobs to the queue. They start to be applied on the next tick. Must be called on the server.
+	void EnqueueJobs(const TArray<FInventoryRestockJob>& Jobs);
+
+	bool IsRestockInProgress() const { return CurrentPortionIndex < PendingPortions.Num(); }
+
+	/**
+	 * Called after each frame of restocking.
+	 * @param CompletedItemsNumber Number of items that were processed so far (including the ones that didn't fit).
+	 * @param TotalItemsNumber Number of items in all enqueued jobs.
+	 */
+	DECLARE_MULTICAST_DELEGATE_TwoParams(FOnRestockProgressDelegate, int32 CompletedItemsNumber,
+		int32 TotalItemsNumber);
+
+	FOnRestockProgressDelegate OnRestockProgress;
+
+	// Called when all enqueued jobs were applied
+	FSimpleMulticastDelegate OnRestockCompleted;
+
+private:
+	// Maximum time in milliseconds that can be spent on restocking per frame
+	UPROPERTY(Config)
+	float FrameBudgetMilliseconds = 1.0f;
+
+	TArray<FInventoryRestockJob> PendingJobs;
+
+	// Items of all pending jobs in the order they are added
+	UPROPERTY(Transient)
+	TArray<FInventoryRestockPortion> PendingPortions;
+
+	// Index of the portion that is added next
+	int32 CurrentPortionIndex = 0;
+
+	int32 CompletedItemsNumber = 0;
+	int32 TotalItemsNumber = 0;
+
+	// Adds the next portion to its inventory. The rest of the job is skipped if the inventory is full.
+	void ApplyNextPortion();
+
+	/**
+	 * Skips the portions from the current one that belong to the job.
+	 * @return Number of the skipped items.
+	 */
+	int32 SkipJobPortions(const int32 JobIndex);
+
+	void FinishRestock();
+};
@@ -2,12 +2,16 @@
 
 #include "AbilitySystem/Abilities/InteractGameplayAbility.h"
 
+#include "AbilitySystem/Abilities/AbilityComponents/EndOnInputReleaseGameplayAbilityComponent.h"
 #include "Characters/EscapeChroniclesCharacter.h"
 #include "Components/ActorComponents/InteractionManagerComponent.h"
 
 UInteractGameplayAbility::UInteractGameplayAbility()
 {
 	NetExecutionPolicy = EGameplayAbilityNetExecutionPolicy::LocalOnly;
+
+	// Hold interactions last until the input is released
+	CreateDefaultComponent<UEndOnInputReleaseGameplayAbilityComponent>(TEXT("EndOnInputRelease"));
 }
 
 void UInteractGameplayAbility::ActivateAbility(const FGameplayAbilitySpecHandle Handle,
@@ -43,5 +47,24 @@ void UInteractGameplayAbility::ActivateAbility(const FGameplayAbilitySpecHandle
 		return;
 	}
 
-	EndAbility(Handle, ActorInfo, ActivationInfo, false, false);
+	// Hold interactions are ended by the end-on-release component
+	if (!InteractionManagerComponent->IsHoldingInteraction())
+	{
+		EndAbility(Handle, ActorInfo, ActivationInfo, false, false);
+	}
+}
+
+void UInteractGameplayAbility::EndAbility(const FGameplayAbilitySpecHandle Handle,
+	const FGameplayAbilityActorInfo* ActorInfo, const FGameplayAbilityActivationInfo ActivationInfo,
+	bool bReplicateEndAbility, bool bWasCancelled)
+{
+	const AEscapeChroniclesCharacter* Character = Cast<AEscapeChroniclesCharacter>(ActorInfo->AvatarActor);
+
+	// Releasing the input before the hold is completed stops it. Does nothing if the hold was already completed.
+	if (IsValid(Character))
+	{
+		Character->GetInteractionManagerComponent()->StopHoldInteraction();
+	}
+
+	Super::EndAbility(Handle, ActorInfo, ActivationInfo, bReplicateEndAbility, bWasCancelled);
 }
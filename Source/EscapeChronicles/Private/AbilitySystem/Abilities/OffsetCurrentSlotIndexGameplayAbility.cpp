@@ -54,7 +54,7 @@ void UOffsetCurrentSlotIndexGameplayAbility::ActivateAbility(const FGameplayAbil
 		return;
 	}
 
-	InventoryManagerSelectorFragment->Server_OffsetCurrentSlotIndex(Offset);
+	InventoryManagerSelectorFragment->OffsetCurrentSlotIndex(Offset);
 
 	EndAbility(Handle, ActorInfo, ActivationInfo, false, false);
 }
@@ -0,0 +1,135 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Actors/EscapeChroniclesInventoryContainer.h"
+
+#include "EscapeChroniclesGameplayTags.h"
+#include "ActorComponents/InventoryManagerComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Components/ActorComponents/InteractableComponent.h"
+#include "Components/ActorComponents/InteractionManagerComponent.h"
+
+AEscapeChroniclesInventoryContainer::AEscapeChroniclesInventoryContainer()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	bReplicates = true;
+
+	MeshComponent = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("Mesh"));
+	SetRootComponent(MeshComponent);
+
+	InventoryManagerComponent = CreateDefaultSubobject<UInventoryManagerComponent>(TEXT("Inventory Manager Component"));
+
+	// Only the players who opened the container need to know what's inside
+	InventoryManagerComponent->SetItemsReplicationPolicy(EInventoryItemsReplicationPolicy::Subscribers);
+
+	InteractableComponent = CreateDefaultSubobject<UInteractableComponent>(TEXT("InteractableComponent"));
+	InteractableComponent->AddInteractionTag(EscapeChroniclesGameplayTags::Interaction_Container);
+
+	MeshComponent->ComponentTags.Add(InteractableComponent->GetHintMeshTag());
+}
+
+void AEscapeChroniclesInventoryContainer::BeginPlay()
+{
+	Super::BeginPlay();
+
+	InteractableComponent->OnInteract.AddUObject(this, &ThisClass::OnInteract);
+}
+
+void AEscapeChroniclesInventoryContainer::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	GetWorldTimerManager().ClearTimer(CloseDistanceCheckTimerHandle);
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void AEscapeChroniclesInventoryContainer::OnInteract(UInteractionManagerComponent* InteractionManagerComponent)
+{
+#if DO_CHECK
+	check(IsValid(InteractionManagerComponent))
+#endif
+
+	const APawn* Pawn = InteractionManagerComponent->GetOwner<APawn>();
+
+	if (!ensureAlways(IsValid(Pawn)))
+	{
+		return;
+	}
+
+	// Bots don't look into containers, so there is nobody to replicate the items to
+	APlayerController* PlayerController = Pawn->GetController<APlayerController>();
+
+	if (!IsValid(PlayerController))
+	{
+		return;
+	}
+
+	if (IsOpenedBy(PlayerController))
+	{
+		Close(PlayerController);
+	}
+	else
+	{
+		Open(PlayerController);
+	}
+}
+
+void AEscapeChroniclesInventoryContainer::Open(APlayerController* PlayerController)
+{
+#if DO_ENSURE
+	ensureAlways(HasAuthority());
+#endif
+
+	InventoryManagerComponent->AddSubscriber(PlayerController);
+
+	if (!GetWorldTimerManager().IsTimerActive(CloseDistanceCheckTimerHandle))
+	{
+		GetWorldTimerManager().SetTimer(CloseDistanceCheckTimerHandle, this, &ThisClass::CheckCloseDistance,
+			CloseDistanceCheckInterval, true);
+	}
+}
+
+void AEscapeChroniclesInventoryContainer::Close(APlayerController* PlayerController)
+{
+#if DO_ENSURE
+	ensureAlways(HasAuthority());
+#endif
+
+	InventoryManagerComponent->RemoveSubscriber(PlayerController);
+
+	if (InventoryManagerComponent->GetSubscribers().IsEmpty())
+	{
+		GetWorldTimerManager().ClearTimer(CloseDistanceCheckTimerHandle);
+	}
+}
+
+bool AEscapeChroniclesInventoryContainer::IsOpenedBy(const APlayerController* PlayerController) const
+{
+	return InventoryManagerComponent->IsSubscriber(PlayerController);
+}
+
+void AEscapeChroniclesInventoryContainer::CheckCloseDistance()
+{
+	InventoryManagerComponent->RemoveInvalidSubscribers();
+
+	const FVector ContainerLocation = GetActorLocation();
+
+	// Copy the subscribers because closing the container removes them from the array
+	const TArray<TWeakObjectPtr<APlayerController>> Subscribers = InventoryManagerComponent->GetSubscribers();
+
+	for (const TWeakObjectPtr<APlayerController>& Subscriber : Subscribers)
+	{
+		APlayerController* PlayerController = Subscriber.Get();
+		const APawn* Pawn = PlayerController->GetPawn();
+
+		if (!IsValid(Pawn) ||
+			FVector::DistSquared(Pawn->GetActorLocation(), ContainerLocation) > FMath::Square(CloseDistance))
+		{
+			Close(PlayerController);
+		}
+	}
+
+	if (InventoryManagerComponent->GetSubscribers().IsEmpty())
+	{
+		GetWorldTimerManager().ClearTimer(CloseDistanceCheckTimerHandle);
+	}
+}
@@ -2,6 +2,7 @@
 
 #include "Actors/EscapeChroniclesInventoryPickupItem.h"
 
+#include "EscapeChroniclesGameplayTags.h"
 #include "ActorComponents/InventoryManagerComponent.h"
 #include "Characters/EscapeChroniclesCharacter.h"
 #include "Components/ActorComponents/InteractableComponent.h"
@@ -10,6 +11,7 @@
 AEscapeChroniclesInventoryPickupItem::AEscapeChroniclesInventoryPickupItem()
 {
 	InteractableComponent = CreateDefaultSubobject<UInteractableComponent>(TEXT("InteractableComponent"));
+	InteractableComponent->AddInteractionTag(EscapeChroniclesGameplayTags::Interaction_Pickup);
 
 	GetMesh()->ComponentTags.Add(InteractableComponent->GetHintMeshTag());
 }
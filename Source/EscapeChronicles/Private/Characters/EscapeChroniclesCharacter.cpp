@@ -11,7 +11,6 @@
 #include "Components/CapsuleComponent.h"
 #include "GameFramework/SpringArmComponent.h"
 #include "Components/ArrowComponent.h"
-#include "Components/BoxComponent.h"
 #include "Components/ActorComponents/InteractionManagerComponent.h"
 #include "Components/CharacterMoverComponents/EscapeChroniclesCharacterMoverComponent.h"
 #include "DefaultMovementSet/NavMoverComponent.h"
@@ -104,12 +103,12 @@ AEscapeChroniclesCharacter::AEscapeChroniclesCharacter()
 
 	InteractionManagerComponent->SetupAttachment(RootComponent);
 
-	InteractionZone = CreateDefaultSubobject<UBoxComponent>(TEXT("Interaction Zone"));
-	InteractionZone->SetupAttachment(InteractionManagerComponent);
-
 	// === Inventory ===
 
 	InventoryManagerComponent = CreateDefaultSubobject<UInventoryManagerComponent>(TEXT("Inventory Manager Component"));
+
+	// Nobody except the owner needs to know what exactly the character carries
+	InventoryManagerComponent->SetItemsReplicationPolicy(EInventoryItemsReplicationPolicy::OwnerOnly);
 }
 
 UAbilitySystemComponent* AEscapeChroniclesCharacter::GetAbilitySystemComponent() const
@@ -161,6 +160,19 @@ void AEscapeChroniclesCharacter::BeginPlay()
 	InitialMeshRotation = MeshComponent->GetRelativeRotation();
 }
 
+void AEscapeChroniclesCharacter::OnPreSaveObject()
+{
+	InventoryManagerComponent->SaveContent(SavedInventoryContent);
+}
+
+void AEscapeChroniclesCharacter::OnPostLoadObject()
+{
+	InventoryManagerComponent->LoadContent(SavedInventoryContent);
+
+	// The loaded data is no longer needed
+	SavedInventoryContent.Reset();
+}
+
 void AEscapeChroniclesCharacter::Tick(float DeltaSeconds)
 {
 	Super::Tick(DeltaSeconds);
@@ -52,4 +52,10 @@ namespace EscapeChroniclesGameplayTags
 	UE_DEFINE_GAMEPLAY_TAG_COMMENT(Role_Guard, "Role.Guard", "The character is a guard");
 	UE_DEFINE_GAMEPLAY_TAG_COMMENT(Role_NPC, "Role.NPC", "The character is controlled by an AI");
 	UE_DEFINE_GAMEPLAY_TAG_COMMENT(Role_Player, "Role.Player", "The character is controlled by a real player");
+
+	// === Interaction tags ===
+
+	UE_DEFINE_GAMEPLAY_TAG_COMMENT(Interaction_Pickup, "Interaction.Pickup", "An item that can be picked up");
+	UE_DEFINE_GAMEPLAY_TAG_COMMENT(Interaction_Container, "Interaction.Container",
+		"A container that can be opened to see its items");
 }
\ No newline at end of file
@@ -108,6 +108,16 @@ protected:
 
 	virtual void SetCurrentActivationInfo(const FGameplayAbilityActivationInfo ActivationInfo) override;
 
+	// Creates a component that the ability has by default. Must be called only from constructors.
+	template<typename T>
+	T* CreateDefaultComponent(const FName SubobjectName)
+	{
+		T* Component = CreateDefaultSubobject<T>(SubobjectName);
+		Components.Add(Component);
+
+		return Component;
+	}
+
 private:
 	// The components that this ability is using. Can be used to expand the functionality of the ability modularly.
 	UPROPERTY(EditDefaultsOnly, Instanced, meta=(DisplayName="Components", ShowOnlyInnerProperties))
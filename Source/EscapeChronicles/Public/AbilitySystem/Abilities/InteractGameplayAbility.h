@@ -6,7 +6,12 @@
 #include "AbilitySystem/Abilities/EscapeChroniclesGameplayAbility.h"
 #include "InteractGameplayAbility.generated.h"
 
-// Allows you to interact with actor that have UInteractableComponent through own UInteractionManagerComponent
+/**
+ * Allows you to interact with actor that have UInteractableComponent through own UInteractionManagerComponent.\n
+ * Ends immediately after an instant interaction. Ends when the input is released (by the default
+ * UEndOnInputReleaseGameplayAbilityComponent) if the interaction has to be held, and stops the hold if it wasn't
+ * completed yet.
+ */
 UCLASS()
 class ESCAPECHRONICLES_API UInteractGameplayAbility : public UEscapeChroniclesGameplayAbility
 {
@@ -18,4 +23,7 @@ public:
 protected:
 	virtual void ActivateAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo,
 		const FGameplayAbilityActivationInfo ActivationInfo, const FGameplayEventData* TriggerEventData) override; 
+
+	virtual void EndAbility(const FGameplayAbilitySpecHandle Handle, const FGameplayAbilityActorInfo* ActorInfo,
+		const FGameplayAbilityActivationInfo ActivationInfo, bool bReplicateEndAbility, bool bWasCancelled) override;
 };
@@ -0,0 +1,64 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "EscapeChroniclesInventoryContainer.generated.h"
+
+class UInteractableComponent;
+class UInteractionManagerComponent;
+class UInventoryManagerComponent;
+
+/**
+ * Container (e.g., a locker or a desk) whose items are replicated only to the players that opened it. Interacting with
+ * the container opens or closes it for the player, and the container is closed automatically when the player walks
+ * away from it.
+ */
+UCLASS()
+class ESCAPECHRONICLES_API AEscapeChroniclesInventoryContainer : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	AEscapeChroniclesInventoryContainer();
+
+	UInventoryManagerComponent* GetInventoryManagerComponent() const { return InventoryManagerComponent; }
+
+	// Starts replicating the items of the container to the player
+	void Open(APlayerController* PlayerController);
+
+	// Stops replicating the items of the container to the player
+	void Close(APlayerController* PlayerController);
+
+	bool IsOpenedBy(const APlayerController* PlayerController) const;
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta=(AllowPrivateAccess="true"))
+	TObjectPtr<UStaticMeshComponent> MeshComponent;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta=(AllowPrivateAccess="true"))
+	TObjectPtr<UInventoryManagerComponent> InventoryManagerComponent;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta=(AllowPrivateAccess="true"))
+	TObjectPtr<UInteractableComponent> InteractableComponent;
+
+	// Distance from the container at which it's closed for the player who opened it
+	UPROPERTY(EditAnywhere, Category="Container", meta=(ClampMin=0, UIMin=0, ForceUnits="cm"))
+	float CloseDistance = 600.0f;
+
+	// How often the distance to the players who opened the container is checked
+	UPROPERTY(EditAnywhere, Category="Container", meta=(ClampMin=0.01, UIMin=0.01, ForceUnits="s"))
+	float CloseDistanceCheckInterval = 0.5f;
+
+	FTimerHandle CloseDistanceCheckTimerHandle;
+
+	void OnInteract(UInteractionManagerComponent* InteractionManagerComponent);
+
+	// Closes the container for the players who walked away from it or left the game
+	void CheckCloseDistance();
+};
@@ -8,10 +8,10 @@
 #include "Interfaces/Saveable.h"
 #include "ActiveGameplayEffectHandle.h"
 #include "Common/Enums/Mover/GroundSpeedMode.h"
+#include "Common/Structs/SaveData/InventorySaveData.h"
 #include "EscapeChroniclesCharacter.generated.h"
 
 class UInventoryManagerComponent;
-class UBoxComponent;
 class UInteractionManagerComponent;
 class UEscapeChroniclesCharacterMoverComponent;
 class UCapsuleComponent;
@@ -117,6 +117,9 @@ protected:
 
 	virtual void OnPlayerStateChanged(APlayerState* NewPlayerState, APlayerState* OldPlayerState) override;
 
+	virtual void OnPreSaveObject() override;
+	virtual void OnPostLoadObject() override;
+
 	// Whether we author our movement inputs relative to whatever base we're standing on, or leave them in world space
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Movement")
 	bool bUseBaseRelativeMovement = true;
@@ -216,9 +219,6 @@ private:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components|Interaction", meta=(AllowPrivateAccess="true"))
 	TObjectPtr<UInteractionManagerComponent> InteractionManagerComponent;
 
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components|Interaction", meta=(AllowPrivateAccess="true"))
-	TObjectPtr<UBoxComponent> InteractionZone;
-
 	// Camera boom positioning the camera behind the character
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components|Camera", meta=(AllowPrivateAccess="true"))
 	TObjectPtr<USpringArmComponent> CameraBoomComponent;
@@ -236,6 +236,10 @@ private:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category="Components", meta=(AllowPrivateAccess="true"))
 	TObjectPtr<UInventoryManagerComponent> InventoryManagerComponent;
 
+	// Content of the InventoryManagerComponent that is saved in the save game object
+	UPROPERTY(Transient, SaveGame)
+	FInventorySaveData SavedInventoryContent;
+
 	// Movement input (intent or velocity) the last time we had one that wasn't zero
 	FVector LastAffirmativeMoveInput = FVector::ZeroVector;
 
@@ -40,4 +40,9 @@ namespace EscapeChroniclesGameplayTags
 	ESCAPECHRONICLES_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Role_Guard);
 	ESCAPECHRONICLES_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Role_NPC);
 	ESCAPECHRONICLES_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Role_Player);
+
+	// === Interaction tags ===
+
+	ESCAPECHRONICLES_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Interaction_Pickup);
+	ESCAPECHRONICLES_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(Interaction_Container);
 }
\ No newline at end of file